@@ -1,5 +1,12 @@
 #include "SPChessArrayList.h"
 
+/**
+ *  The array list is a circular buffer: its elements are kept in order starting at the index "first" of the
+ *  elements array, and wrapping around to its beginning. Therefore adding or removing an element at either end
+ *  of the list (in particular removing the oldest move of a full game history and adding the new one) doesn't
+ *  shift the other elements.
+ */
+
 /**
  *  Creates an empty array list with the specified maximum capacity.
  *  @param maxSize - the maximum capacity of the target array list.
@@ -20,6 +27,7 @@ SPArrayList* spArrayListCreate(int maxSize){
 	}
 	list->maxSize = maxSize;
 	list->actualSize = 0;
+	list->first = 0;
 	return list;
 }
 
@@ -49,12 +57,14 @@ SP_ARRAY_LIST_MESSAGE spArrayListClear(SPArrayList* src){
 	if (src == NULL)
 		return SP_ARRAY_LIST_INVALID_ARGUMENT;
 	src->actualSize =0;
+	src->first = 0;
 	return SP_ARRAY_LIST_SUCCESS;
 }
 
 /**
  * Inserts element at a specified index. The elements residing at and after the
- * specified index will be shifted to make place for the new element. If the
+ * specified index will be shifted to make place for the new element, unless the
+ * element is inserted at the beginning or at the end of the list. If the
  * array list reached its maximum capacity and error message is returned and
  * the source list is not affected
  * @param src   - the source array list
@@ -71,9 +81,13 @@ SP_ARRAY_LIST_MESSAGE spArrayListAddAt(SPArrayList* src, Move* elem, int index){
 		return SP_ARRAY_LIST_INVALID_ARGUMENT;
 	if (spArrayListIsFull(src))
 		return SP_ARRAY_LIST_FULL;
-	for (int i=src->actualSize; i>index; i--)
-		src->elements[i] = src->elements[i-1];
-	src->elements[index] = *elem;
+	if (index == 0 && src->actualSize > 0) //the list starts one element earlier
+		src->first = (src->first + src->maxSize - 1) % src->maxSize;
+	else {
+		for (int i=src->actualSize; i>index; i--)
+			src->elements[spArrayListElementIndex(src, i)] = src->elements[spArrayListElementIndex(src, i-1)];
+	}
+	src->elements[spArrayListElementIndex(src, index)] = *elem;
 	src->actualSize++;
 	return SP_ARRAY_LIST_SUCCESS;
 }
@@ -95,7 +109,8 @@ SP_ARRAY_LIST_MESSAGE spArrayListAddLast(SPArrayList* src, Move* elem){
 
 /**
  * Removes an element from a specified index and frees the pointer.
- * The elements residing after the specified index will be shifted to make to keep the list continuous.
+ * The elements residing after the specified index will be shifted to make to keep the list continuous,
+ * unless the element is removed from the beginning or from the end of the list.
  * If the array list is empty then an error message is returned and the source list
  * is not affected
  * @param src   - The source array list
@@ -112,14 +127,18 @@ SP_ARRAY_LIST_MESSAGE spArrayListRemoveAt(SPArrayList* src, int index){
 	if (spArrayListIsEmpty(src))
 		return SP_ARRAY_LIST_EMPTY;
 	src->actualSize--;
-	for (int i=index; i<spArrayListSize(src); i++)
-		src->elements[i] = src->elements[i+1];
+	if (index == 0) //the list starts one element later
+		src->first = (src->first + 1) % src->maxSize;
+	else {
+		for (int i=index; i<spArrayListSize(src); i++)
+			src->elements[spArrayListElementIndex(src, i)] = src->elements[spArrayListElementIndex(src, i+1)];
+	}
 	return SP_ARRAY_LIST_SUCCESS;
 }
 
 /**
  * Removes an element from a the beginning of the list.
- * The elements will be shifted to make to keep the list continuous. If the
+ * The other elements are not shifted (the list just starts one element later). If the
  * array list is empty then an error message is returned and the source list
  * is not affected
  * @param src   - The source array list
@@ -134,7 +153,7 @@ SP_ARRAY_LIST_MESSAGE spArrayListRemoveFirst(SPArrayList* src){
 
 /**
  * Removes an element from a the end of the list.
- * The elements will be shifted to make to keep the list continuous. If the
+ * The other elements are not shifted. If the
  * array list is empty then an error message is returned and the source list
  * is not affected
  * @param src   - The source array list
@@ -160,7 +179,7 @@ SP_ARRAY_LIST_MESSAGE spArrayListRemoveLast(SPArrayList* src){
 Move* spArrayListGetAt(SPArrayList* src, int index){
 	if ((src == NULL) || (index < 0) || (index >= spArrayListSize(src)))
 		return NULL;
-	return &src->elements[index];
+	return &src->elements[spArrayListElementIndex(src, index)];
 }
 
 /**
@@ -213,3 +232,16 @@ bool spArrayListIsFull(SPArrayList* src){
 bool spArrayListIsEmpty(SPArrayList* src){
 	return (spArrayListSize(src) == 0);
 }
+
+/**
+ * Returns the index in the elements array of the element at the specified index of the list
+ * (the list starts at the index "first" of the array and wraps around to its beginning).
+ * The function is called with the assertion that all arguments are valid.
+ * @param src - the source array list
+ * @param index - the specified index, the index is 0-based.
+ * @return
+ * The index of the element in the elements array.
+ */
+int spArrayListElementIndex(SPArrayList* src, int index){
+	return (src->first + index) % src->maxSize;
+}
@@ -0,0 +1,191 @@
+#include "SPChessBench.h"
+
+/**
+ * The suite: the initial position, "Kiwipete" and positions of all the stages of a game (openings, middle games with
+ * attacks on both kings, and endgames of every kind of pieces).
+ */
+static const BenchPosition benchPositions[NUM_OF_BENCH_POSITIONS] = {
+	{ "initial",
+	  { "RNBQKBNR", "MMMMMMMM", "________", "________", "________", "________", "mmmmmmmm", "rnbqkbnr" },
+	  WHITE_PLAYER, true , true , true , true },
+	{ "kiwipete",
+	  { "R___K__R", "M_MMQMB_", "BN__MNM_", "___mn___", "_M__m___", "__n__q_M", "mmmbbmmm", "r___k__r" },
+	  WHITE_PLAYER, true , true , true , true },
+	{ "rook endgame",
+	  { "________", "__M_____", "___M____", "km_____R", "_r___M_K", "________", "____m_m_", "________" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "queen attack",
+	  { "____RRK_", "MM_N___M", "___Q__Mq", "__M_MB__", "__mm____", "__m___n_", "m__b__mm", "____rrk_" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "opposite castles",
+	  { "RQ___RK_", "MMM__MMM", "_BNMB___", "___n__b_", "___nm___", "_______m", "mmmq_mm_", "__kr___r" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "kingside attack",
+	  { "R_BQ_R_K", "_MM_N_MM", "_M_M____", "____M__q", "____mM__", "_bnm____", "mmm__mmm", "___r_rk_" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "queen raid",
+	  { "R___R_K_", "__M__MMM", "M_M_BN__", "________", "_Q__m___", "__nmqn__", "mmm___mm", "r____rk_" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "knight fork",
+	  { "R_BBK_NR", "MM___M_M", "__N_____", "_n____M_", "__nM_b__", "________", "mmm__mmm", "__kr_b_r" },
+	  WHITE_PLAYER, false, false, true , true },
+	{ "center tension",
+	  { "R_BQ_RK_", "MMM_NMMM", "____N___", "___M___q", "___m____", "_bm_b___", "mm_n__mm", "r____rk_" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "pinned bishop",
+	  { "____R_K_", "R_Q__MMM", "MMM__N__", "____m___", "_____rB_", "_n_bq___", "mmm___mm", "r_____k_" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "open center",
+	  { "__RQKB_R", "MMM__M__", "__NMB_M_", "_n_nN__M", "__m_mm__", "________", "mm__b_mm", "r_bqk__r" },
+	  BLACK_PLAYER, true , true , false, false },
+	{ "closed center",
+	  { "R_BQ_R_K", "B_M_NMM_", "M__M___M", "_M______", "___mm___", "_b__nn__", "mm___mmm", "r__q_rk_" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "queenside play",
+	  { "___R_RK_", "M_____MM", "BMM_MM__", "________", "Q_mm_m__", "B___m___", "m__nqrmm", "_r__b_k_" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "passed pawn",
+	  { "R_Q__RK_", "__M_BMMM", "__mM____", "M______B", "q_mnM___", "____b___", "mm_r_mmm", "__k____r" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "seventh rank",
+	  { "____K__R", "_MB__MMM", "_M__M___", "_r_M____", "___m____", "__R_mn__", "m____mmm", "_r____k_" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "minor pieces",
+	  { "___Q__K_", "MB___M_M", "____MBM_", "__R_____", "mMn__n__", "_m__m__m", "_____mm_", "q__r__k_" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "knight endgame",
+	  { "______K_", "______M_", "______mM", "MMM_____", "___MN__m", "_m___k__", "_mm__m__", "___n____" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "pawn chain",
+	  { "___B____", "_____KM_", "_M_M_M_M", "Mm_mMm_m", "m_m_m___", "___kn___", "________", "________" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "rook race",
+	  { "__k_____", "M_______", "_______m", "_____Mr_", "________", "_____K__", "R_______", "________" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "queen endgame",
+	  { "________", "______MK", "_M______", "________", "mm___M_M", "_____m__", "____km_Q", "___q____" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "queen checks",
+	  { "_______K", "___M__MM", "____Q___", "________", "____q___", "_____kM_", "m______B", "________" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "king opposition",
+	  { "________", "__M_____", "________", "__KmkM_M", "__M____m", "__m_____", "___m____", "________" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "outside passer",
+	  { "________", "_M___MM_", "_______M", "_____m_m", "__K___m_", "________", "__k__m__", "________" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "rook and pawns",
+	  { "________", "MM__R_K_", "__M_M___", "___Mm__M", "_m_m_m_m", "m_____kr", "________", "________" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "bishop blockade",
+	  { "________", "___M____", "M_BK___M", "mM______", "_kM_mMmM", "__m__m_m", "__m_____", "_____b__" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "rook defence",
+	  { "_____K__", "_______r", "____m__M", "_____k__", "M_R__m_M", "________", "________", "________" },
+	  BLACK_PLAYER, false, false, false, false },
+	{ "knight and rook",
+	  { "______K_", "______M_", "m______M", "R_n_____", "_____M__", "_______m", "_B___mm_", "____r_k_" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "queen and bishops",
+	  { "_R___K__", "____Q___", "__mM___B", "___bM___", "__q__M__", "_M_m__m_", "_m__km__", "___n____" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "bishop endgame",
+	  { "______K_", "____MM_M", "___M__M_", "m_MmB___", "r_______", "_R__m_mm", "___b_m__", "______k_" },
+	  WHITE_PLAYER, false, false, false, false },
+	{ "wrong bishop",
+	  { "________", "___M___b", "_____M__", "_____m__", "M_______", "mm_____B", "K_______", "______k_" },
+	  WHITE_PLAYER, false, false, false, false }
+};
+
+/**
+ * The function searches all the positions of the suite to BENCH_DEPTH, and prints the number of nodes of every search.
+ * Then, the total number of nodes (the signature of the search), the time of all the searches and the search speed are printed.
+ * The output is either text or a JSON object (for the tools that compare the results of different versions).
+ *
+ * @param jsonOutput - Whether the results are printed as a JSON object
+ *
+ * @return
+ * 		False - If a memory error occurred.
+ * 		True  - Otherwise.
+ */
+bool spChessBench(bool jsonOutput) {
+	SPChessGame* game = spChessGameCreate();
+	if (game == NULL)
+		return false;
+
+	long long totalNodes = 0;
+	long long elapsedMs  = 0;
+
+	if (jsonOutput)
+		PRINT_BENCH_JSON_OPENING(BENCH_DEPTH);
+
+	for (int positionNum = 0; positionNum < NUM_OF_BENCH_POSITIONS; positionNum++) {
+		const BenchPosition* position = &(benchPositions[positionNum]);
+
+		// only the search is timed (emptying the transposition table takes a time that depends on its size)
+		setBenchPosition(game, position);
+
+		long long startTime = spTimerNowMs();
+		long long nodes     = benchSearch(game);
+		elapsedMs += spTimerNowMs() - startTime;
+
+		if (nodes < 0) {
+			spChessGameDestroy(game);
+			return false;
+		}
+
+		if (jsonOutput)
+			PRINT_BENCH_JSON_POSITION(position->name, nodes, (positionNum == (NUM_OF_BENCH_POSITIONS - 1)));
+		else
+			PRINT_BENCH_POSITION(position->name, nodes);
+
+		totalNodes += nodes;
+	}
+
+	long long nodesPerSecond = (totalNodes * MS_IN_SECOND) / ((elapsedMs > 0) ? elapsedMs : 1);
+
+	if (jsonOutput)
+		PRINT_BENCH_JSON_SUMMARY(totalNodes, elapsedMs, nodesPerSecond);
+	else
+		PRINT_BENCH_SUMMARY(BENCH_DEPTH, totalNodes, elapsedMs, nodesPerSecond);
+
+	spChessGameDestroy(game);
+	return true;
+}
+
+/**
+ * The function sets the given game to a position of the suite, and empties the transposition table, so the search of every
+ * position doesn't depend on the positions before it.
+ *
+ * @param game     - A Chess game
+ * @param position - A position of the suite
+ */
+void setBenchPosition(SPChessGame* game, const BenchPosition* position) {
+	setGamePosition(game, position->rows, position->currentPlayer, position->whiteLeftCastle, position->whiteRightCastle,
+					position->blackLeftCastle, position->blackRightCastle);
+	spChessTTClear();
+}
+
+/**
+ * The function searches the position of the given game (a position of the suite, see setBenchPosition) to BENCH_DEPTH with
+ * BENCH_SEARCH_THREADS (one thread).
+ *
+ * @param game - A Chess game
+ *
+ * @return
+ * 		-1 if a memory error occurred.
+ * 		Otherwise, the number of nodes that were searched (the nodes of the search's statistics, that include the nodes of the
+ * 		 quiescence search).
+ */
+long long benchSearch(SPChessGame* game) {
+	Move* move = spChessMinimaxMove(game, BENCH_DEPTH, BENCH_SEARCH_THREADS);
+	if (move == NULL)
+		return -1;
+
+	free(move);
+
+	SearchStatistics statistics;
+	spChessMinimaxGetStatistics(&statistics);
+
+	return statistics.nodes;
+}
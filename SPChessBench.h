@@ -0,0 +1,49 @@
+#ifndef SPCHESSBENCH_H_
+#define SPCHESSBENCH_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "SPChessMinimax.h"
+#include "SPChessTimer.h"
+
+/**
+ * SPChessBench Summary:
+ *
+ * "Bench" searches a fixed suite of positions to a fixed depth with the Minimax algorithm (see spChessMinimaxMove), with one
+ * thread and an empty transposition table for every position, and reports the total number of nodes that were searched,
+ * the time it took and the search speed.
+ * The search is deterministic, so the total number of nodes is a signature of the search: a change that changes the
+ * search (its pruning, its move ordering or its evaluation) changes the signature, and a change that only makes it faster
+ * keeps the signature and raises the speed. The signature depends on the size of the transposition table as well.
+ *
+ * spChessBench - Searches all the positions of the suite and prints the results (as text or as JSON)
+ */
+
+#define BENCH_DEPTH            6
+#define BENCH_SEARCH_THREADS   1 // the node count of a search is only reproducible with one thread
+#define NUM_OF_BENCH_POSITIONS 30
+
+#define PRINT_BENCH_POSITION(name, n)                 printf("%-20s nodes: %12lld\n", name, n)
+#define PRINT_BENCH_SUMMARY(d, n, ms, nps)            printf("Depth: %d\nNodes: %lld\nTime: %lld ms\nNodes per second: %lld\n", d, n, ms, nps)
+#define PRINT_BENCH_JSON_OPENING(d)                   printf("{\n  \"depth\": %d,\n  \"positions\": [\n", d)
+#define PRINT_BENCH_JSON_POSITION(name, n, isLast)    printf("    { \"name\": \"%s\", \"nodes\": %lld }%s\n", name, n, ((isLast) ? "" : ","))
+#define PRINT_BENCH_JSON_SUMMARY(n, ms, nps)          printf("  ],\n  \"nodes\": %lld,\n  \"timeMs\": %lld,\n  \"nps\": %lld\n}\n", n, ms, nps)
+
+/**
+ * A position of the suite: its board (from the 8th row down to the 1st row, as in a saved game file), the player
+ * that is its turn to play and its castling indicators.
+ */
+typedef struct bench_position_t {
+	const char* name;
+	const char* rows[BOARD_LENGTH];
+	int         currentPlayer;
+	bool        whiteLeftCastle, whiteRightCastle, blackLeftCastle, blackRightCastle;
+} BenchPosition;
+
+bool spChessBench(bool jsonOutput);
+
+void setBenchPosition(SPChessGame* game, const BenchPosition* position);
+
+long long benchSearch(SPChessGame* game);
+
+#endif
@@ -0,0 +1,543 @@
+#include "SPChessBitboard.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * The attack tables of the sliding pieces (the rook's table is also used for the queen's rook-like movement, and the
+ * bishop's table for its bishop-like movement). Every square gets its own slice of the table, that is indexed by the
+ * occupancy of the squares relevant to the piece's movement from that square (see slidingTableIndex).
+ */
+static Bitboard   rookAttacksTable[ROOK_ATTACKS_TABLE_SIZE];
+static Bitboard   bishopAttacksTable[BISHOP_ATTACKS_TABLE_SIZE];
+static SliderInfo rookInfo[NUM_OF_SQUARES];
+static SliderInfo bishopInfo[NUM_OF_SQUARES];
+
+/**
+ * The lines tables: the whole line that passes through two squares, and the squares between them
+ * (both are empty for two squares that are not on the same row, column or diagonal).
+ */
+static Bitboard lineTable[NUM_OF_SQUARES][NUM_OF_SQUARES];
+static Bitboard betweenTable[NUM_OF_SQUARES][NUM_OF_SQUARES];
+
+/**
+ * The attack tables of the knight, the king and the pawns (indexed by the color of the pawn: white pawns at index true).
+ * Their attacks don't depend on the occupancy of the board, so every square has a single entry.
+ */
+static Bitboard knightAttacksTable[NUM_OF_SQUARES];
+static Bitboard kingAttacksTable[NUM_OF_SQUARES];
+static Bitboard pawnAttacksTable[NUM_OF_PLAYERS][NUM_OF_SQUARES];
+
+static const DIRECTION rookDirections[NUM_OF_SLIDER_DIRECTIONS]   = { DIRECTION_UP, DIRECTION_DOWN, DIRECTION_LEFT, DIRECTION_RIGHT };
+static const DIRECTION bishopDirections[NUM_OF_SLIDER_DIRECTIONS] = { DIRECTION_UP_LEFT, DIRECTION_UP_RIGHT, DIRECTION_DOWN_LEFT, DIRECTION_DOWN_RIGHT };
+
+#if !defined(__BMI2__)
+static const uint64_t magicSeeds[BITBOARD_ROW_LENGTH] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+#endif
+
+/**
+ * The function returns the square of the least significant bit that is set in the given bitboard.
+ *
+ * @param bitboard - A bitboard
+ *
+ * @precondition - bitboard is not empty
+ *
+ * @return
+ * 		The square (0-based, (row * 8) + col) of the least significant bit of the bitboard.
+ */
+int spBitboardFirstSquare(Bitboard bitboard) {
+	return __builtin_ctzll(bitboard);
+}
+
+/**
+ * The function returns the square of the least significant bit that is set in the given bitboard,
+ * and clears that bit from the bitboard.
+ * Calling this function until the bitboard gets empty goes over all of its squares in ascending order.
+ *
+ * @param bitboard - A pointer to a bitboard
+ *
+ * @precondition - The bitboard is not empty
+ *
+ * @return
+ * 		The square of the bit that was cleared.
+ */
+int spBitboardPopFirstSquare(Bitboard* bitboard) {
+	int square = spBitboardFirstSquare(*bitboard);
+	*bitboard &= (*bitboard - 1); // clears the least significant bit
+
+	return square;
+}
+
+/**
+ * The function counts the number of squares that are set in the given bitboard.
+ *
+ * @param bitboard - A bitboard
+ *
+ * @return
+ * 		The number of bits that are set in the bitboard.
+ */
+int spBitboardCountSquares(Bitboard bitboard) {
+	return __builtin_popcountll(bitboard);
+}
+
+/**
+ * The function shifts all the squares of the given bitboard one step towards the given direction.
+ * Squares that would "wrap around" the left or the right edge of the board are dropped, and that's
+ * why the first/last column is masked out after a shift to the right/left.
+ *
+ * @param bitboard  - A bitboard
+ * @param direction - The direction to shift the squares towards
+ *
+ * @return
+ * 		The shifted bitboard.
+ */
+Bitboard spBitboardShift(Bitboard bitboard, DIRECTION direction) {
+	switch (direction) {
+		case DIRECTION_UP:
+			return (bitboard << BITBOARD_ROW_LENGTH);
+
+		case DIRECTION_DOWN:
+			return (bitboard >> BITBOARD_ROW_LENGTH);
+
+		case DIRECTION_LEFT:
+			return ((bitboard >> 1) & ~LAST_COL_BITBOARD);
+
+		case DIRECTION_RIGHT:
+			return ((bitboard << 1) & ~FIRST_COL_BITBOARD);
+
+		case DIRECTION_UP_LEFT:
+			return ((bitboard << (BITBOARD_ROW_LENGTH - 1)) & ~LAST_COL_BITBOARD);
+
+		case DIRECTION_UP_RIGHT:
+			return ((bitboard << (BITBOARD_ROW_LENGTH + 1)) & ~FIRST_COL_BITBOARD);
+
+		case DIRECTION_DOWN_LEFT:
+			return ((bitboard >> (BITBOARD_ROW_LENGTH + 1)) & ~LAST_COL_BITBOARD);
+
+		case DIRECTION_DOWN_RIGHT:
+			return ((bitboard >> (BITBOARD_ROW_LENGTH - 1)) & ~FIRST_COL_BITBOARD);
+	}
+
+	return EMPTY_BITBOARD;
+}
+
+/**
+ * The function calculates the squares that a sliding piece (bishop/rook/queen) located at the given square
+ * attacks along the given direction.
+ * The ray goes on until it either leaves the board or hits an occupied square. The occupied square that stopped
+ * the ray is included in the attacks (it is up to the caller to decide if it is a capture or a blocker).
+ *
+ * @param square    - The square of the sliding piece
+ * @param occupancy - A bitboard of all the occupied squares on the board
+ * @param direction - The direction of the ray
+ *
+ * @return
+ * 		The squares that are attacked along the ray.
+ */
+Bitboard spBitboardRayAttacks(int square, Bitboard occupancy, DIRECTION direction) {
+	Bitboard attacks = EMPTY_BITBOARD;
+	Bitboard ray     = SQUARE_BITBOARD(square);
+
+	do {
+		ray      = spBitboardShift(ray, direction);
+		attacks |= ray;
+	} while ((ray != EMPTY_BITBOARD) && !(ray & occupancy));
+
+	return attacks;
+}
+
+/**
+ * The function builds the attack tables of all the pieces, so the attacks of a piece are found later with a single lookup.
+ * It should be called once, before any game is created.
+ * The tables of the knight, the king and the pawns are built by calling initLeaperTables, and the tables of the sliding pieces
+ * (bishops, rooks and queens) are built here, so their attacks are found without walking along their rays.
+ * The lines tables, that are derived from the sliding pieces attacks, are built at the end (by calling initLineTables).
+ * For every square we take the "relevant occupancy" mask of the piece (the squares along its rays, without the last square of every
+ * ray, since a piece there can't block anything), and store the attacks of every subset of that mask at the index of the subset.
+ * When the CPU supports the PEXT instruction (BMI2) the index is the subset's bits extracted from the mask, otherwise a "magic"
+ * multiplier is searched for every square so that multiplying a subset by it maps the subset to a unique (enough) index.
+ */
+void spBitboardInitAttackTables(void) {
+	int rookOffset   = 0;
+	int bishopOffset = 0;
+
+	initLeaperTables();
+
+	for (int square = 0; square < NUM_OF_SQUARES; square++) {
+		initSliderSquare(&(rookInfo[square])  , &(rookAttacksTable[rookOffset])    , square, rookDirections);
+		initSliderSquare(&(bishopInfo[square]), &(bishopAttacksTable[bishopOffset]), square, bishopDirections);
+
+		rookOffset   += (1 << spBitboardCountSquares(rookInfo[square].mask));
+		bishopOffset += (1 << spBitboardCountSquares(bishopInfo[square].mask));
+	}
+
+	initLineTables();
+}
+
+/**
+ * The function builds the attack tables of the knight, the king and the pawns (see spBitboardInitAttackTables).
+ * The attacks of every square are calculated once by shifting the square's bitboard, so the move generators and the threat
+ * checks never shift bitboards or check the edges of the board for these pieces.
+ */
+void initLeaperTables(void) {
+	for (int square = 0; square < NUM_OF_SQUARES; square++) {
+		knightAttacksTable[square]      = knightAttacksByShifts(square);
+		kingAttacksTable[square]        = kingAttacksByShifts(square);
+		pawnAttacksTable[true][square]  = pawnAttacksByShifts(true, square);
+		pawnAttacksTable[false][square] = pawnAttacksByShifts(false, square);
+	}
+}
+
+/**
+ * The function calculates the squares that a knight located at the given square attacks
+ * (the 8 squares that create an "L" shape with the knight's square, if they are on the board). Used only for building its table.
+ *
+ * @param square - The square of the knight
+ *
+ * @return
+ * 		The squares that are attacked by the knight.
+ */
+Bitboard knightAttacksByShifts(int square) {
+	Bitboard knight     = SQUARE_BITBOARD(square);
+	Bitboard horizontal = spBitboardShift(knight, DIRECTION_LEFT) | spBitboardShift(knight, DIRECTION_RIGHT);
+	Bitboard twoColumns = spBitboardShift(spBitboardShift(knight, DIRECTION_LEFT) , DIRECTION_LEFT)
+						| spBitboardShift(spBitboardShift(knight, DIRECTION_RIGHT), DIRECTION_RIGHT);
+
+	// one column sidewards and two rows upwards/downwards, or two columns sidewards and one row upwards/downwards
+	return (   (horizontal << (2 * BITBOARD_ROW_LENGTH)) | (horizontal >> (2 * BITBOARD_ROW_LENGTH))
+			|  (twoColumns << BITBOARD_ROW_LENGTH)       | (twoColumns >> BITBOARD_ROW_LENGTH));
+}
+
+/**
+ * The function calculates the squares that a king located at the given square attacks
+ * (the 8 squares that surround the king's square, if they are on the board). Used only for building its table.
+ *
+ * @param square - The square of the king
+ *
+ * @return
+ * 		The squares that are attacked by the king.
+ */
+Bitboard kingAttacksByShifts(int square) {
+	Bitboard king = SQUARE_BITBOARD(square);
+	Bitboard row  = king | spBitboardShift(king, DIRECTION_LEFT) | spBitboardShift(king, DIRECTION_RIGHT);
+
+	return ((row | spBitboardShift(row, DIRECTION_UP) | spBitboardShift(row, DIRECTION_DOWN)) & ~king);
+}
+
+/**
+ * The function calculates the squares that a pawn located at the given square attacks
+ * (i.e. the two squares that the pawn can "eat" diagonally, if they are on the board). Used only for building its table.
+ *
+ * @param whitePawn - Indicates if it is a white pawn (advancing upwards) or a black pawn (advancing downwards)
+ * @param square    - The square of the pawn
+ *
+ * @return
+ * 		The squares that are attacked by the pawn.
+ */
+Bitboard pawnAttacksByShifts(bool whitePawn, int square) {
+	Bitboard pawn = SQUARE_BITBOARD(square);
+
+	if (whitePawn)
+		return (spBitboardShift(pawn, DIRECTION_UP_LEFT)   | spBitboardShift(pawn, DIRECTION_UP_RIGHT));
+
+	return (spBitboardShift(pawn, DIRECTION_DOWN_LEFT) | spBitboardShift(pawn, DIRECTION_DOWN_RIGHT));
+}
+
+/**
+ * The function returns the squares that a knight located at the given square attacks.
+ *
+ * @param square - The square of the knight
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The squares that are attacked by the knight.
+ */
+Bitboard spBitboardKnightAttacks(int square) {
+	return knightAttacksTable[square];
+}
+
+/**
+ * The function returns the squares that a king located at the given square attacks.
+ *
+ * @param square - The square of the king
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The squares that are attacked by the king.
+ */
+Bitboard spBitboardKingAttacks(int square) {
+	return kingAttacksTable[square];
+}
+
+/**
+ * The function returns the squares that a pawn located at the given square attacks.
+ *
+ * @param whitePawn - Indicates if it is a white pawn (advancing upwards) or a black pawn (advancing downwards)
+ * @param square    - The square of the pawn
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The squares that are attacked by the pawn.
+ */
+Bitboard spBitboardPawnAttacks(bool whitePawn, int square) {
+	return pawnAttacksTable[whitePawn][square];
+}
+
+/**
+ * The function builds the attack table slice of one sliding piece on one square (see spBitboardInitAttackTables).
+ * The magic search uses a fixed seed for every row (seeds that are known to find the multipliers after few attempts),
+ * so the same multipliers (and therefore the same tables) are built on every run.
+ *
+ * @param info       - The lookup information of the square, that is filled by the function
+ * @param attacks    - The slice of the attacks table of the square
+ * @param square     - The square of the sliding piece
+ * @param directions - The four directions the sliding piece moves towards
+ */
+void initSliderSquare(SliderInfo* info, Bitboard* attacks, int square, const DIRECTION directions[]) {
+	Bitboard subsets[MAX_SLIDER_SUBSETS];
+	Bitboard subsetAttacks[MAX_SLIDER_SUBSETS];
+	int      subsetsAmount = 0;
+	Bitboard subset        = EMPTY_BITBOARD;
+
+	info->mask    = sliderRelevantOccupancy(square, directions);
+	info->shift   = (NUM_OF_SQUARES - spBitboardCountSquares(info->mask));
+	info->magic   = EMPTY_BITBOARD;
+	info->attacks = attacks;
+
+	// going over all the subsets of the mask ("Carry-Rippler" trick), including the empty subset
+	do {
+		subsets[subsetsAmount]       = subset;
+		subsetAttacks[subsetsAmount] = sliderAttacksByRays(square, subset, directions);
+		subsetsAmount++;
+		subset = ((subset - info->mask) & info->mask);
+	} while (subset != EMPTY_BITBOARD);
+
+#if !defined(__BMI2__)
+	int      usedAt[MAX_SLIDER_SUBSETS]; // the attempt that last filled every index, so the table is not cleared between attempts
+	uint64_t seed = magicSeeds[SQUARE_ROW(square)];
+	int      attempt;
+	bool     found = false;
+
+	for (int index = 0; index < subsetsAmount; index++)
+		usedAt[index] = 0;
+
+	for (attempt = 1; !found; attempt++) {
+		// a good magic has few set bits, and maps the mask to enough different bits at the top of the product
+		do {
+			info->magic = (magicRandom(&seed) & magicRandom(&seed) & magicRandom(&seed));
+		} while (spBitboardCountSquares((info->mask * info->magic) >> MAGIC_TOP_BITS_SHIFT) < MIN_MAGIC_TOP_BITS);
+
+		found = true;
+		for (int i = 0; (found && (i < subsetsAmount)); i++) {
+			int index = slidingTableIndex(info, subsets[i]);
+
+			// two subsets may share an index only if they have the same attacks
+			if (usedAt[index] != attempt) {
+				usedAt[index]  = attempt;
+				attacks[index] = subsetAttacks[i];
+			}
+			else if (attacks[index] != subsetAttacks[i])
+				found = false;
+		}
+	}
+#else
+	for (int i = 0; i < subsetsAmount; i++)
+		attacks[slidingTableIndex(info, subsets[i])] = subsetAttacks[i];
+#endif
+}
+
+/**
+ * The function calculates the "relevant occupancy" mask of a sliding piece on the given square: all the squares along its
+ * rays except for the last square of every ray (whether a piece occupies that square or not, the ray ends there anyway).
+ *
+ * @param square     - The square of the sliding piece
+ * @param directions - The four directions the sliding piece moves towards
+ *
+ * @return
+ * 		The relevant occupancy mask.
+ */
+Bitboard sliderRelevantOccupancy(int square, const DIRECTION directions[]) {
+	Bitboard mask = EMPTY_BITBOARD;
+
+	for (int i = 0; i < NUM_OF_SLIDER_DIRECTIONS; i++) {
+		Bitboard ray = spBitboardRayAttacks(square, EMPTY_BITBOARD, directions[i]);
+
+		while (ray != EMPTY_BITBOARD) {
+			Bitboard position = SQUARE_BITBOARD(spBitboardPopFirstSquare(&ray));
+
+			if (spBitboardShift(position, directions[i]) != EMPTY_BITBOARD) // not the last square of the ray
+				mask |= position;
+		}
+	}
+
+	return mask;
+}
+
+/**
+ * The function calculates the squares that a sliding piece on the given square attacks by walking along each of its rays
+ * (used only for building the attack tables).
+ *
+ * @param square     - The square of the sliding piece
+ * @param occupancy  - A bitboard of the occupied squares on the board
+ * @param directions - The four directions the sliding piece moves towards
+ *
+ * @return
+ * 		The squares that are attacked by the sliding piece.
+ */
+Bitboard sliderAttacksByRays(int square, Bitboard occupancy, const DIRECTION directions[]) {
+	Bitboard attacks = EMPTY_BITBOARD;
+
+	for (int i = 0; i < NUM_OF_SLIDER_DIRECTIONS; i++)
+		attacks |= spBitboardRayAttacks(square, occupancy, directions[i]);
+
+	return attacks;
+}
+
+/**
+ * The function returns the next number of a "xorshift64*" pseudo random sequence (used for searching the magic multipliers).
+ *
+ * @param seed - A pointer to the state of the sequence, that is advanced by the function
+ *
+ * @return
+ * 		The next pseudo random number.
+ */
+uint64_t magicRandom(uint64_t* seed) {
+	*seed ^= (*seed >> 12);
+	*seed ^= (*seed << 25);
+	*seed ^= (*seed >> 27);
+
+	return (*seed * MAGIC_RANDOM_MULTIPLIER);
+}
+
+/**
+ * The function calculates the index of the given occupancy in the attack table slice of a sliding piece's square.
+ *
+ * @param info      - The lookup information of the square
+ * @param occupancy - A bitboard of the occupied squares on the board
+ *
+ * @return
+ * 		The index in the attack table slice of the square.
+ */
+int slidingTableIndex(const SliderInfo* info, Bitboard occupancy) {
+#if defined(__BMI2__)
+	return (int) _pext_u64(occupancy, info->mask);
+#else
+	return (int) (((occupancy & info->mask) * info->magic) >> info->shift);
+#endif
+}
+
+/**
+ * The function returns the squares that a bishop located at the given square attacks along its four diagonals.
+ *
+ * @param square    - The square of the bishop
+ * @param occupancy - A bitboard of all the occupied squares on the board
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The squares that are attacked by the bishop (including the first occupied square along each diagonal).
+ */
+Bitboard spBitboardBishopAttacks(int square, Bitboard occupancy) {
+	const SliderInfo* info = &(bishopInfo[square]);
+
+	return info->attacks[slidingTableIndex(info, occupancy)];
+}
+
+/**
+ * The function returns the squares that a rook located at the given square attacks along its row and column.
+ *
+ * @param square    - The square of the rook
+ * @param occupancy - A bitboard of all the occupied squares on the board
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The squares that are attacked by the rook (including the first occupied square along each direction).
+ */
+Bitboard spBitboardRookAttacks(int square, Bitboard occupancy) {
+	const SliderInfo* info = &(rookInfo[square]);
+
+	return info->attacks[slidingTableIndex(info, occupancy)];
+}
+
+/**
+ * The function returns the squares that a queen located at the given square attacks.
+ * The queen's movement is the union of the bishop's and the rook's movements, so it takes one lookup in each table.
+ *
+ * @param square    - The square of the queen
+ * @param occupancy - A bitboard of all the occupied squares on the board
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The squares that are attacked by the queen.
+ */
+Bitboard spBitboardQueenAttacks(int square, Bitboard occupancy) {
+	return (spBitboardBishopAttacks(square, occupancy) | spBitboardRookAttacks(square, occupancy));
+}
+
+/**
+ * The function builds the lines tables, using the attacks of the sliding pieces on an empty board:
+ * Two squares are on the same line if a rook (row/column) or a bishop (diagonal) on one of them attacks the other.
+ * In that case, the line is the intersection of the attacks from both squares plus the two squares themselves,
+ * and the squares between them are the intersection of the attacks when each square blocks the other's ray.
+ *
+ * @precondition - The attack tables of the sliding pieces were built
+ */
+void initLineTables(void) {
+	for (int squareA = 0; squareA < NUM_OF_SQUARES; squareA++) {
+		for (int squareB = 0; squareB < NUM_OF_SQUARES; squareB++) {
+			Bitboard positionA = SQUARE_BITBOARD(squareA);
+			Bitboard positionB = SQUARE_BITBOARD(squareB);
+
+			lineTable[squareA][squareB]    = EMPTY_BITBOARD;
+			betweenTable[squareA][squareB] = EMPTY_BITBOARD;
+
+			if (spBitboardRookAttacks(squareA, EMPTY_BITBOARD) & positionB) {
+				lineTable[squareA][squareB]    = (  (spBitboardRookAttacks(squareA, EMPTY_BITBOARD) & spBitboardRookAttacks(squareB, EMPTY_BITBOARD))
+												  | positionA | positionB);
+				betweenTable[squareA][squareB] = (spBitboardRookAttacks(squareA, positionB) & spBitboardRookAttacks(squareB, positionA));
+			}
+			else if (spBitboardBishopAttacks(squareA, EMPTY_BITBOARD) & positionB) {
+				lineTable[squareA][squareB]    = (  (spBitboardBishopAttacks(squareA, EMPTY_BITBOARD) & spBitboardBishopAttacks(squareB, EMPTY_BITBOARD))
+												  | positionA | positionB);
+				betweenTable[squareA][squareB] = (spBitboardBishopAttacks(squareA, positionB) & spBitboardBishopAttacks(squareB, positionA));
+			}
+		}
+	}
+}
+
+/**
+ * The function returns the whole line (row, column or diagonal, from one edge of the board to the other)
+ * that passes through the two given squares.
+ *
+ * @param squareA - A square
+ * @param squareB - Another square
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The line that passes through the two squares, or EMPTY_BITBOARD if they are not on the same line.
+ */
+Bitboard spBitboardLine(int squareA, int squareB) {
+	return lineTable[squareA][squareB];
+}
+
+/**
+ * The function returns the squares between the two given squares (not including the squares themselves).
+ *
+ * @param squareA - A square
+ * @param squareB - Another square
+ *
+ * @precondition - spBitboardInitAttackTables was called
+ *
+ * @return
+ * 		The squares between the two squares, or EMPTY_BITBOARD if they are not on the same line (or are adjacent).
+ */
+Bitboard spBitboardBetween(int squareA, int squareB) {
+	return betweenTable[squareA][squareB];
+}
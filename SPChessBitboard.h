@@ -0,0 +1,143 @@
+#ifndef SPCHESSBITBOARD_H_
+#define SPCHESSBITBOARD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * SPChessBitboard Summary:
+ *
+ * A bitboard is a 64 bit word where every bit represents one position on the Chess board.
+ * The bit of the position (row,col) is bit number ((row * 8) + col), so the least significant bit
+ * is the position <1,A> and the most significant bit is the position <8,H>.
+ * Iterating a bitboard from its least significant bit to its most significant bit therefore goes over the
+ * positions bottom-up as the main order and left-to-right as the secondary order.
+ *
+ * spBitboardFirstSquare      - Returns the square of the least significant bit of a bitboard
+ * spBitboardPopFirstSquare   - Returns the square of the least significant bit of a bitboard and clears it
+ * spBitboardCountSquares     - Returns the number of squares that are set in a bitboard
+ * spBitboardShift            - Shifts all the squares of a bitboard one step towards a given direction
+ * spBitboardRayAttacks       - Returns the squares attacked along one direction, given the board occupancy
+ * spBitboardInitAttackTables - Builds the attack tables of all the pieces and the line tables (called once at startup)
+ * spBitboardKnightAttacks    - Returns the squares attacked by a knight (a table lookup)
+ * spBitboardKingAttacks      - Returns the squares attacked by a king (a table lookup)
+ * spBitboardPawnAttacks      - Returns the squares attacked by a white pawn or by a black pawn (a table lookup)
+ * spBitboardBishopAttacks    - Returns the squares attacked by a bishop, given the board occupancy (a table lookup)
+ * spBitboardRookAttacks      - Returns the squares attacked by a rook, given the board occupancy (a table lookup)
+ * spBitboardQueenAttacks     - Returns the squares attacked by a queen, given the board occupancy (a table lookup)
+ * spBitboardLine             - Returns the whole line (row, column or diagonal) that passes through two squares
+ * spBitboardBetween          - Returns the squares between two squares that are on the same line
+ */
+
+#define NUM_OF_SQUARES      64
+#define NUM_OF_PLAYERS      2
+#define BITBOARD_ROW_LENGTH 8
+
+#define EMPTY_BITBOARD               ((Bitboard) 0)
+#define FULL_BITBOARD                (~EMPTY_BITBOARD)
+#define SQUARE_BITBOARD(square)      (((Bitboard) 1) << (square))
+#define POSITION_TO_SQUARE(row, col) (((row) * BITBOARD_ROW_LENGTH) + (col))
+#define SQUARE_ROW(square)           ((square) / BITBOARD_ROW_LENGTH)
+#define SQUARE_COL(square)           ((square) % BITBOARD_ROW_LENGTH)
+
+#define FIRST_COL_BITBOARD ((Bitboard) 0x0101010101010101ULL)
+#define LAST_COL_BITBOARD  ((Bitboard) 0x8080808080808080ULL)
+#define FIRST_ROW_BITBOARD ((Bitboard) 0x00000000000000FFULL)
+
+#define NUM_OF_SLIDER_DIRECTIONS  4
+#define ROOK_ATTACKS_TABLE_SIZE   102400 // the sum of (2 ^ relevant occupancy squares) of the rook over all the squares
+#define BISHOP_ATTACKS_TABLE_SIZE 5248   // the sum of (2 ^ relevant occupancy squares) of the bishop over all the squares
+#define MAX_SLIDER_SUBSETS        4096   // a rook in a corner has 12 relevant occupancy squares
+#define MAGIC_RANDOM_MULTIPLIER   0x2545F4914F6CDD1DULL
+#define MAGIC_TOP_BITS_SHIFT      56
+#define MIN_MAGIC_TOP_BITS        6
+
+typedef uint64_t Bitboard;
+
+/**
+ * The type of a piece regardless of its color, used as an index to the bitboards of the game.
+ */
+typedef enum piece_type_t {
+	PAWN_TYPE,
+	KNIGHT_TYPE,
+	BISHOP_TYPE,
+	ROOK_TYPE,
+	QUEEN_TYPE,
+	KING_TYPE,
+	NUM_OF_PIECE_TYPES
+} PIECE_TYPE;
+
+/**
+ * The eight directions a piece can move towards (up means towards the black player's side of the board).
+ */
+typedef enum direction_t {
+	DIRECTION_UP,
+	DIRECTION_DOWN,
+	DIRECTION_LEFT,
+	DIRECTION_RIGHT,
+	DIRECTION_UP_LEFT,
+	DIRECTION_UP_RIGHT,
+	DIRECTION_DOWN_LEFT,
+	DIRECTION_DOWN_RIGHT
+} DIRECTION;
+
+/**
+ * The lookup information of a sliding piece on one square: the squares that can block its rays (the relevant occupancy mask),
+ * the magic multiplier and shift that map a blockers subset to an index, and the square's slice of the attacks table.
+ */
+typedef struct slider_info_t {
+	Bitboard  mask;
+	Bitboard  magic;
+	int       shift;
+	Bitboard* attacks;
+} SliderInfo;
+
+int spBitboardFirstSquare(Bitboard bitboard);
+
+int spBitboardPopFirstSquare(Bitboard* bitboard);
+
+int spBitboardCountSquares(Bitboard bitboard);
+
+Bitboard spBitboardShift(Bitboard bitboard, DIRECTION direction);
+
+Bitboard spBitboardRayAttacks(int square, Bitboard occupancy, DIRECTION direction);
+
+void spBitboardInitAttackTables(void);
+
+void initLeaperTables(void);
+
+Bitboard knightAttacksByShifts(int square);
+
+Bitboard kingAttacksByShifts(int square);
+
+Bitboard pawnAttacksByShifts(bool whitePawn, int square);
+
+Bitboard spBitboardKnightAttacks(int square);
+
+Bitboard spBitboardKingAttacks(int square);
+
+Bitboard spBitboardPawnAttacks(bool whitePawn, int square);
+
+void initSliderSquare(SliderInfo* info, Bitboard* attacks, int square, const DIRECTION directions[]);
+
+Bitboard sliderRelevantOccupancy(int square, const DIRECTION directions[]);
+
+Bitboard sliderAttacksByRays(int square, Bitboard occupancy, const DIRECTION directions[]);
+
+uint64_t magicRandom(uint64_t* seed);
+
+int slidingTableIndex(const SliderInfo* info, Bitboard occupancy);
+
+Bitboard spBitboardBishopAttacks(int square, Bitboard occupancy);
+
+Bitboard spBitboardRookAttacks(int square, Bitboard occupancy);
+
+Bitboard spBitboardQueenAttacks(int square, Bitboard occupancy);
+
+void initLineTables(void);
+
+Bitboard spBitboardLine(int squareA, int squareB);
+
+Bitboard spBitboardBetween(int squareA, int squareB);
+
+#endif
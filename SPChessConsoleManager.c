@@ -41,7 +41,7 @@ bool GameState(GameSetting* setting){
 	TurnStatus turnStatus = TURN_IS_NOT_DONE; // the status of the current turn
 
 	if (setting->isGameLoaded != GAME_LOADED_SUCCESSFULLY){ // if a game has not been loaded in the setting state
-		setting->game = spChessGameCreate(HISTORY_SIZE);
+		setting->game = spChessGameCreate();
 		if (setting->game == NULL){
 			MEMORY_ALLOCATION_PERROR;
 			return true;
@@ -77,6 +77,7 @@ bool GameState(GameSetting* setting){
  * his/her move by printing a message to the relevant user. The message will be printed each time a user
  * has to make a move. In case an error occurs (for example the user enters an invalid move), then
  * the message is printed again.
+ * In the one player mode, the computer ponders on the user's time (see spChessMinimaxPonderStart) until the user's turn is over.
  *
  * @param game 	  - the game to be updated
  * @param setting - the setting of the game
@@ -95,6 +96,8 @@ TurnStatus userTurn(SPChessGame* game, GameSetting* setting){
 	char str[SP_MAX_LINE_LENGTH];
 
 	spChessGamePrintBoard(game);
+	ponderOnUserTurn(setting, game);
+
 	do {
 		(game->currentPlayer == WHITE_PLAYER) ? PRINT_USER_TURN_MESSAGE(WHITE_PLAYER_LOWER_CASE_STRING):
 				PRINT_USER_TURN_MESSAGE(BLACK_PLAYER_LOWER_CASE_STRING);
@@ -102,9 +105,25 @@ TurnStatus userTurn(SPChessGame* game, GameSetting* setting){
 		command = spParserParseLine(str, false);
 		turnStatus = GameCommandHandler(game, command, setting);
 	} while (turnStatus != DONE && turnStatus != QUIT_GAME && turnStatus != RESET_GAME);
+
+	spChessMinimaxPonderStop();
 	return turnStatus;
 }
 
+/**
+ * Starts the computer's pondering on the user's time (see spChessMinimaxPonderStart) in 1 player mode.
+ * The pondering is stopped when the user's turn is over, or before an undo, redo or jump command changes the game.
+ *
+ * @param setting - the setting of the game
+ * @param game    - the game to ponder on
+ * @precondition setting != NULL
+ * @precondition game != NULL
+ */
+void ponderOnUserTurn(GameSetting* setting, SPChessGame* game){
+	if (setting->gameMode == ONE_PLAYER_MODE)
+		spChessMinimaxPonderStart(game, setting->difficulty, setting->searchThreads);
+}
+
 /**
  * After getting a move from the Minimax function, the function updates the game
  * and prints the computer's move.
@@ -122,7 +141,7 @@ TurnStatus computerTurn(SPChessGame* game, GameSetting* setting){
 	int kingRow, kingColInt, srcRow, dstRow;
 	char kingCol, srcCol, dstCol, *srcPiece;
 
-	Move* move = spChessMinimaxMove(game, setting->difficulty);
+	Move* move = spChessMinimaxMove(game, setting->difficulty, setting->searchThreads);
 
 	if (move != NULL && move->castleMove == true){
 		kingRow = (game->currentPlayer == WHITE_PLAYER) ? (game->whiteKingRow+1) : (game->blackKingRow+1);
@@ -184,6 +203,12 @@ TurnStatus GameCommandHandler(SPChessGame* game, SPCommand command, GameSetting*
 	if (command.cmd == SP_UNDO_MOVE)
 		return undoCommandHandler(setting, game);
 
+	if (command.cmd == SP_REDO_MOVE)
+		return redoCommandHandler(setting, game);
+
+	if (command.cmd == SP_JUMP_TO_PLY)
+		return jumpCommandHandler(setting, game, command);
+
 	if (command.cmd == SP_RESET){
 		PRINT_RESET_MESSAGE;
 		return RESET_GAME;
@@ -394,7 +419,9 @@ void printPossibleMoves(SPArrayList* possibleMoves){
 }
 
 /**
- * Handles an undo command and prints a suitable message.
+ * Handles an undo command and prints a suitable message for every move that was undone.
+ * In 1 player mode the last move of the computer and the last move of the user are undone,
+ * and in 2 players mode only the last move is undone. The history of the game has no size limit.
  * After an undo command is executed, the board game is printed.
  * However, if there's a check from previous rounds, a message about that is NOT printed.
  *
@@ -404,31 +431,100 @@ void printPossibleMoves(SPArrayList* possibleMoves){
  * @precondition		  game != NULL
  *
  * @return
- * RETRY 			if the command is not supported by the game settings
- * 					or if the game history is empty
+ * RETRY 			if the game history is empty
  * TURN_IS_NOT_DONE if the command has been executed successfully
  */
 TurnStatus undoCommandHandler(GameSetting* setting, SPChessGame* game){
-	if (setting->gameMode == TWO_PLAYERS_MODE){
-		UNDO_NOT_AVAILABLE_PERROR;
-		return RETRY;
-	}
-	if (!spChessGameIsUndoPossible(game, setting->userColor)){
+	bool twoPlayersMode = (setting->gameMode == TWO_PLAYERS_MODE);
+
+	if (twoPlayersMode ? (spUndoStackPly(game->history) == 0) : !spChessGameIsUndoPossible(game, setting->userColor)){
 		UNDO_EMPTY_HISTORY_PERROR;
 		return RETRY;
 	}
 
-	Move* lastMove = spArrayListGetLast(game->history);
-	SP_CHESS_GAME_MESSAGE message = spChessGameUndoPrevMove(game, lastMove);
-	Move* beforeLastMove = spArrayListGetLast(game->history);
-	message = spChessGameUndoPrevMove(game, beforeLastMove);
+	Move undoneMove;
+	int numOfMoves = twoPlayersMode ? ONLY_ONE_MOVE : MOVES_PER_ROUND;
 
-	if (message == SP_CHESS_GAME_SUCCESS){
-		PRINT_UNDO_MOVE_MESSAGE(game->currentPlayer ? BLACK_PLAYER_LOWER_CASE_STRING : WHITE_PLAYER_LOWER_CASE_STRING,
-				lastMove->dstRow+1, (char)(FIRST_COL_SYMBOL+lastMove->dstCol), lastMove->srcRow+1, (char)(FIRST_COL_SYMBOL+lastMove->srcCol));
-		PRINT_UNDO_MOVE_MESSAGE(!game->currentPlayer ? BLACK_PLAYER_LOWER_CASE_STRING : WHITE_PLAYER_LOWER_CASE_STRING,
-				beforeLastMove->dstRow+1, (char)(FIRST_COL_SYMBOL+beforeLastMove->dstCol), beforeLastMove->srcRow+1, (char)(FIRST_COL_SYMBOL+beforeLastMove->srcCol));
+	spChessMinimaxPonderStop(); // the computer ponders on a position that is undone
+	for (int i=0; i<numOfMoves && spChessGameUndoPrevMove(game, &undoneMove) == SP_CHESS_GAME_SUCCESS; i++){
+		//after the undo, the current player is the player that made the undone move
+		PRINT_UNDO_MOVE_MESSAGE(game->currentPlayer ? WHITE_PLAYER_LOWER_CASE_STRING : BLACK_PLAYER_LOWER_CASE_STRING,
+				undoneMove.dstRow+1, (char)(FIRST_COL_SYMBOL+undoneMove.dstCol), undoneMove.srcRow+1, (char)(FIRST_COL_SYMBOL+undoneMove.srcCol));
 	}
+	ponderOnUserTurn(setting, game);
 	spChessGamePrintBoard(game); // the board is printed after an undo command
 	return TURN_IS_NOT_DONE;
 }
+
+/**
+ * Handles a redo command: the moves that were undone by the last undo command are set again (as long as no other move
+ * was made since), and a suitable message is printed for every move that was redone.
+ * After a redo command is executed, the board game is printed.
+ *
+ * @param setting		  the game setting
+ * @param game    		  the game to be updated
+ * @precondition 		  setting != NULL
+ * @precondition		  game != NULL
+ *
+ * @return
+ * RETRY 			if there is no undone move
+ * TURN_IS_NOT_DONE if the command has been executed successfully
+ */
+TurnStatus redoCommandHandler(GameSetting* setting, SPChessGame* game){
+	if (!spChessGameIsRedoPossible(game)){
+		REDO_EMPTY_HISTORY_PERROR;
+		return RETRY;
+	}
+
+	Move redoneMove;
+	int numOfMoves = (setting->gameMode == TWO_PLAYERS_MODE) ? ONLY_ONE_MOVE : MOVES_PER_ROUND;
+
+	spChessMinimaxPonderStop(); // the computer ponders on a position that is left
+	for (int i=0; i<numOfMoves && spChessGameRedoMove(game, &redoneMove) == SP_CHESS_GAME_SUCCESS; i++){
+		//after the redo, the current player is the rival of the player that made the redone move
+		PRINT_REDO_MOVE_MESSAGE(game->currentPlayer ? BLACK_PLAYER_LOWER_CASE_STRING : WHITE_PLAYER_LOWER_CASE_STRING,
+				redoneMove.srcRow+1, (char)(FIRST_COL_SYMBOL+redoneMove.srcCol), redoneMove.dstRow+1, (char)(FIRST_COL_SYMBOL+redoneMove.dstCol));
+	}
+	ponderOnUserTurn(setting, game);
+	spChessGamePrintBoard(game); // the board is printed after a redo command
+	return TURN_IS_NOT_DONE;
+}
+
+/**
+ * Handles a jump command: the game is moved to the position after the given number of moves (counted from the position the
+ * game was started or loaded from), by undoing or redoing moves. In 1 player mode the ply should be a ply where it's the
+ * user's turn to play.
+ * After a jump command is executed, the board game is printed.
+ *
+ * @param setting		  the game setting
+ * @param game    		  the game to be updated
+ * @param command 		  the user's command, after parsing it
+ * @precondition 		  setting != NULL
+ * @precondition		  game != NULL
+ *
+ * @return
+ * RETRY 			if the ply is not a valid ply of the game history, or if a move couldn't be undone or redone on the way
+ * 					to it (the game stays at the ply it got to, and the failure is reported)
+ * TURN_IS_NOT_DONE if the command has been executed successfully
+ */
+TurnStatus jumpCommandHandler(GameSetting* setting, SPChessGame* game, SPCommand command){
+	int ply = command.intArg;
+	bool userTurnAtPly = ((abs(spUndoStackPly(game->history) - ply) % 2) == 0); //it's the user's turn now, so every 2 plies
+
+	if (!command.validIntArg || ply > spUndoStackSize(game->history)
+			|| (setting->gameMode == ONE_PLAYER_MODE && !userTurnAtPly)){
+		JUMP_INVALID_PLY_PERROR(spUndoStackSize(game->history));
+		return RETRY;
+	}
+
+	spChessMinimaxPonderStop(); // the computer ponders on a position that is left
+	if (spChessGameJumpToPly(game, ply) != SP_CHESS_GAME_SUCCESS){
+		JUMP_FAILED_PERROR(spUndoStackPly(game->history));
+		return RETRY;
+	}
+
+	ponderOnUserTurn(setting, game);
+	PRINT_JUMP_MESSAGE(ply);
+	spChessGamePrintBoard(game); // the board is printed after a jump command
+	return TURN_IS_NOT_DONE;
+}
@@ -0,0 +1,229 @@
+#include "SPChessEvaluation.h"
+
+/**
+ * The material of every type of piece (a king has no material, since both players always have their king).
+ */
+static const int midgameMaterial[NUM_OF_PIECE_TYPES] = { PAWN_SCORE, KNIGHT_SCORE, BISHOP_SCORE, ROOK_SCORE, QUEEN_SCORE, 0 };
+static const int endgameMaterial[NUM_OF_PIECE_TYPES] = { PAWN_ENDGAME_SCORE, KNIGHT_ENDGAME_SCORE, BISHOP_ENDGAME_SCORE,
+														 ROOK_ENDGAME_SCORE, QUEEN_ENDGAME_SCORE, 0 };
+static const int phaseWeights[NUM_OF_PIECE_TYPES]    = { 0, KNIGHT_PHASE, BISHOP_PHASE, ROOK_PHASE, QUEEN_PHASE, 0 };
+
+/**
+ * The piece-square tables of the white pieces, written as the board is seen by the white player (the first line is the 8th row).
+ * The pawns are pushed forward (and more so in the endgame), the knights and the bishops are drawn to the center,
+ * the rooks to the 7th row, and the king hides behind its pawns in the midgame and goes to the center in the endgame.
+ */
+static const int midgameTables[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES] = {
+	{ // pawn
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		 50,  50,  50,  50,  50,  50,  50,  50,
+		 10,  10,  20,  30,  30,  20,  10,  10,
+		  5,   5,  10,  25,  25,  10,   5,   5,
+		  0,   0,   0,  20,  20,   0,   0,   0,
+		  5,  -5, -10,   0,   0, -10,  -5,   5,
+		  5,  10,  10, -20, -20,  10,  10,   5,
+		  0,   0,   0,   0,   0,   0,   0,   0
+	},
+	{ // knight
+		-50, -40, -30, -30, -30, -30, -40, -50,
+		-40, -20,   0,   0,   0,   0, -20, -40,
+		-30,   0,  10,  15,  15,  10,   0, -30,
+		-30,   5,  15,  20,  20,  15,   5, -30,
+		-30,   0,  15,  20,  20,  15,   0, -30,
+		-30,   5,  10,  15,  15,  10,   5, -30,
+		-40, -20,   0,   5,   5,   0, -20, -40,
+		-50, -40, -30, -30, -30, -30, -40, -50
+	},
+	{ // bishop
+		-20, -10, -10, -10, -10, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   5,   5,  10,  10,   5,   5, -10,
+		-10,   0,  10,  10,  10,  10,   0, -10,
+		-10,  10,  10,  10,  10,  10,  10, -10,
+		-10,   5,   0,   0,   0,   0,   5, -10,
+		-20, -10, -10, -10, -10, -10, -10, -20
+	},
+	{ // rook
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  5,  10,  10,  10,  10,  10,  10,   5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		  0,   0,   0,   5,   5,   0,   0,   0
+	},
+	{ // queen
+		-20, -10, -10,  -5,  -5, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,   5,   5,   5,   0, -10,
+		 -5,   0,   5,   5,   5,   5,   0,  -5,
+		  0,   0,   5,   5,   5,   5,   0,  -5,
+		-10,   5,   5,   5,   5,   5,   0, -10,
+		-10,   0,   5,   0,   0,   0,   0, -10,
+		-20, -10, -10,  -5,  -5, -10, -10, -20
+	},
+	{ // king
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-20, -30, -30, -40, -40, -30, -30, -20,
+		-10, -20, -20, -20, -20, -20, -20, -10,
+		 20,  20,   0,   0,   0,   0,  20,  20,
+		 20,  30,  10,   0,   0,  10,  30,  20
+	}
+};
+
+static const int endgameTables[NUM_OF_PIECE_TYPES][NUM_OF_SQUARES] = {
+	{ // pawn
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		 80,  80,  80,  80,  80,  80,  80,  80,
+		 50,  50,  50,  50,  50,  50,  50,  50,
+		 30,  30,  30,  30,  30,  30,  30,  30,
+		 15,  15,  15,  15,  15,  15,  15,  15,
+		  5,   5,   5,   5,   5,   5,   5,   5,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0
+	},
+	{ // knight
+		-50, -40, -30, -30, -30, -30, -40, -50,
+		-40, -20,   0,   0,   0,   0, -20, -40,
+		-30,   0,  10,  15,  15,  10,   0, -30,
+		-30,   5,  15,  20,  20,  15,   5, -30,
+		-30,   0,  15,  20,  20,  15,   0, -30,
+		-30,   5,  10,  15,  15,  10,   5, -30,
+		-40, -20,   0,   5,   5,   0, -20, -40,
+		-50, -40, -30, -30, -30, -30, -40, -50
+	},
+	{ // bishop
+		-20, -10, -10, -10, -10, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   5,   5,  10,  10,   5,   5, -10,
+		-10,   0,  10,  10,  10,  10,   0, -10,
+		-10,  10,  10,  10,  10,  10,  10, -10,
+		-10,   5,   0,   0,   0,   0,   5, -10,
+		-20, -10, -10, -10, -10, -10, -10, -20
+	},
+	{ // rook
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  5,  10,  10,  10,  10,  10,  10,   5,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  0,   0,   0,   0,   0,   0,   0,   0
+	},
+	{ // queen
+		-20, -10, -10,  -5,  -5, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,   5,   5,   5,   0, -10,
+		 -5,   0,   5,   5,   5,   5,   0,  -5,
+		 -5,   0,   5,   5,   5,   5,   0,  -5,
+		-10,   0,   5,   5,   5,   5,   0, -10,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-20, -10, -10,  -5,  -5, -10, -10, -20
+	},
+	{ // king
+		-50, -40, -30, -20, -20, -30, -40, -50,
+		-30, -20, -10,   0,   0, -10, -20, -30,
+		-30, -10,  20,  30,  30,  20, -10, -30,
+		-30, -10,  30,  40,  40,  30, -10, -30,
+		-30, -10,  30,  40,  40,  30, -10, -30,
+		-30, -10,  20,  30,  30,  20, -10, -30,
+		-30, -30,   0,   0,   0,   0, -30, -30,
+		-50, -30, -30, -30, -30, -30, -30, -50
+	}
+};
+
+/**
+ * The scores of every (color, piece type, square) combination: the material plus the piece-square bonus,
+ * negated for the black pieces (filled once by spEvaluationInit).
+ */
+static PieceSquareScore pieceSquareScores[NUM_OF_PLAYERS][NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+
+/**
+ * The function builds the scores of all the (color, piece type, square) combinations, so adding or removing a piece from
+ * an accumulator is a single lookup. It should be called once, before any game is created.
+ * A black piece gets the bonus of the white piece on the square that is mirrored along the middle of the board.
+ */
+void spEvaluationInit(void) {
+	for (int type = 0; type < NUM_OF_PIECE_TYPES; type++) {
+		for (int square = 0; square < NUM_OF_SQUARES; square++) {
+			int whiteIndex = MIRROR_SQUARE(square);
+
+			pieceSquareScores[true][type][square].midgameScore  = midgameMaterial[type] + midgameTables[type][whiteIndex];
+			pieceSquareScores[true][type][square].endgameScore  = endgameMaterial[type] + endgameTables[type][whiteIndex];
+			pieceSquareScores[false][type][square].midgameScore = -(midgameMaterial[type] + midgameTables[type][square]);
+			pieceSquareScores[false][type][square].endgameScore = -(endgameMaterial[type] + endgameTables[type][square]);
+		}
+	}
+}
+
+/**
+ * The function empties the given accumulator (the scores and the game phase of an empty board).
+ *
+ * @param evaluation - An evaluation accumulator
+ */
+void spEvaluationClear(Evaluation* evaluation) {
+	evaluation->midgameScore = 0;
+	evaluation->endgameScore = 0;
+	evaluation->phase        = 0;
+}
+
+/**
+ * The function adds a piece of the given color and type on the given square to the given accumulator.
+ *
+ * @param evaluation - An evaluation accumulator
+ * @param whitePiece - Indicates if it is a white piece or a black piece
+ * @param type       - The type of the piece
+ * @param square     - The square of the piece
+ *
+ * @precondition - spEvaluationInit was called
+ */
+void spEvaluationAddPiece(Evaluation* evaluation, bool whitePiece, PIECE_TYPE type, int square) {
+	const PieceSquareScore* score = &(pieceSquareScores[whitePiece][type][square]);
+
+	evaluation->midgameScore += score->midgameScore;
+	evaluation->endgameScore += score->endgameScore;
+	evaluation->phase        += phaseWeights[type];
+}
+
+/**
+ * The function removes a piece of the given color and type on the given square from the given accumulator.
+ *
+ * @param evaluation - An evaluation accumulator
+ * @param whitePiece - Indicates if it is a white piece or a black piece
+ * @param type       - The type of the piece
+ * @param square     - The square of the piece
+ *
+ * @precondition - spEvaluationInit was called, and the piece was added to the accumulator
+ */
+void spEvaluationRemovePiece(Evaluation* evaluation, bool whitePiece, PIECE_TYPE type, int square) {
+	const PieceSquareScore* score = &(pieceSquareScores[whitePiece][type][square]);
+
+	evaluation->midgameScore -= score->midgameScore;
+	evaluation->endgameScore -= score->endgameScore;
+	evaluation->phase        -= phaseWeights[type];
+}
+
+/**
+ * The function returns the evaluation of the given accumulator from the point of view of the given player:
+ * the midgame and the endgame scores are blended by the game phase (a phase above MIDGAME_PHASE, possible after pawn promotions,
+ * counts as a midgame), and the result is negated for the black player.
+ *
+ * @param evaluation  - An evaluation accumulator
+ * @param whitePlayer - Indicates if the evaluation is from the point of view of the white player or the black player
+ *
+ * @return
+ * 		The evaluation in centipawns (a positive evaluation is good for the player).
+ */
+int spEvaluationScore(const Evaluation* evaluation, bool whitePlayer) {
+	int phase = (evaluation->phase < MIDGAME_PHASE) ? evaluation->phase : MIDGAME_PHASE;
+	int score = (  (evaluation->midgameScore * phase) + (evaluation->endgameScore * (MIDGAME_PHASE - phase))) / MIDGAME_PHASE;
+
+	return (whitePlayer ? score : -score);
+}
@@ -0,0 +1,78 @@
+#ifndef SPCHESSEVALUATION_H_
+#define SPCHESSEVALUATION_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "SPChessBitboard.h"
+
+/**
+ * SPChessEvaluation Summary:
+ *
+ * The static evaluation of a position: the material of every piece plus a piece-square bonus (a bonus for a piece of a given type
+ * on a given square), in centipawns. Every piece has a midgame score and an endgame score, and the evaluation of a position blends
+ * the two by the game phase, that is derived from the pieces (other than pawns and kings) that are still on board.
+ * Like the Zobrist key, the evaluation of a game is kept in an accumulator that is updated incrementally as pieces are placed and
+ * removed, so evaluating a position during a search takes only few loads and a single division.
+ *
+ * spEvaluationInit        - Builds the scores of all the (player, piece type, square) combinations (called once at startup)
+ * spEvaluationClear       - Empties an accumulator (the evaluation of an empty board)
+ * spEvaluationAddPiece    - Adds a piece on a square to an accumulator
+ * spEvaluationRemovePiece - Removes a piece on a square from an accumulator
+ * spEvaluationScore       - Returns the evaluation of an accumulator from the point of view of a given player
+ */
+
+// the midgame material of the pieces (also used as the values of the pieces by the search, see pieceScore)
+#define PAWN_SCORE   100
+#define KNIGHT_SCORE 320
+#define BISHOP_SCORE 330
+#define ROOK_SCORE   500
+#define QUEEN_SCORE  900
+
+// the endgame material of the pieces
+#define PAWN_ENDGAME_SCORE   120
+#define KNIGHT_ENDGAME_SCORE 290
+#define BISHOP_ENDGAME_SCORE 320
+#define ROOK_ENDGAME_SCORE   540
+#define QUEEN_ENDGAME_SCORE  960
+
+// the weights of the pieces in the game phase (the sum of the weights of the initial pieces is the midgame phase)
+#define KNIGHT_PHASE   1
+#define BISHOP_PHASE   1
+#define ROOK_PHASE     2
+#define QUEEN_PHASE    4
+#define MIDGAME_PHASE  24
+
+// the piece-square tables are written from the 8th row down to the 1st row, so the square of a white piece is mirrored
+#define MIRROR_SQUARE(square) ((square) ^ (NUM_OF_SQUARES - BITBOARD_ROW_LENGTH))
+
+#define EVALUATION_MISMATCH_ERROR "ERROR: The evaluation of the game doesn't match its position (%s)\n"
+
+/**
+ * An evaluation accumulator: the midgame and the endgame scores of the white pieces minus the scores of the black pieces,
+ * and the game phase (the sum of the phase weights of the pieces on board).
+ */
+typedef struct evaluation_t {
+	int midgameScore;
+	int endgameScore;
+	int phase;
+} Evaluation;
+
+/**
+ * The scores of a piece of a given color and type on a given square (from the point of view of the white player).
+ */
+typedef struct piece_square_score_t {
+	int midgameScore;
+	int endgameScore;
+} PieceSquareScore;
+
+void spEvaluationInit(void);
+
+void spEvaluationClear(Evaluation* evaluation);
+
+void spEvaluationAddPiece(Evaluation* evaluation, bool whitePiece, PIECE_TYPE type, int square);
+
+void spEvaluationRemovePiece(Evaluation* evaluation, bool whitePiece, PIECE_TYPE type, int square);
+
+int spEvaluationScore(const Evaluation* evaluation, bool whitePlayer);
+
+#endif
@@ -1,25 +1,22 @@
 #include "SPChessGame.h"
 
 /**
- * The function creates a new game instant with a specified history size.
+ * The function creates a new game instant.
  * All the game variables that should be initialized get their default values,
- * and the game board gets initialized at the helper function initializeBoard.
+ * and the game board gets initialized at the helper function initializeBoard (the game bitboards are then
+ * initialized according to the board at the helper function initializeBitboards).
+ * The history of the game has no size limit (see SPChessUndoStack), so every move can be undone.
  *
- * @param historySize - The total number of moves to undo, a player can undo
- * 						at most historySize turns (which is actually (historySize / 2))
  * @return
- * 		NULL if either a memory allocation failure occurs or (historySize <= 0).
+ * 		NULL if a memory allocation failure occurs.
  * 		Otherwise, a new game instant is returned.
  */
-SPChessGame* spChessGameCreate(int historySize) {
-	if (historySize <= 0)
-		return NULL;
-
+SPChessGame* spChessGameCreate(void) {
 	SPChessGame* game = (SPChessGame*) malloc(sizeof(SPChessGame));
 	if (game == NULL)
 		return NULL;
 
-	game->history = spArrayListCreate(historySize);
+	game->history = spUndoStackCreate();
 	if (game->history == NULL) {
 		free(game);
 		return NULL;
@@ -27,7 +24,7 @@ SPChessGame* spChessGameCreate(int historySize) {
 
 	game->whiteArmy = (Army*) malloc(sizeof(Army));
 	if (game->whiteArmy == NULL) {
-		spArrayListDestroy(game->history);
+		spUndoStackDestroy(game->history);
 		free(game);
 		return NULL;
 	}
@@ -35,12 +32,13 @@ SPChessGame* spChessGameCreate(int historySize) {
 	game->blackArmy = (Army*) malloc(sizeof(Army));
 	if (game->blackArmy == NULL) {
 		free(game->whiteArmy);
-		spArrayListDestroy(game->history);
+		spUndoStackDestroy(game->history);
 		free(game);
 		return NULL;
 	}
 
 	initializeBoard(game->board);
+	initializeBitboards(game);
 
 	game->currentPlayer           = WHITE_PLAYER;
 	game->whiteLeftCastle         = game->whiteRightCastle = true;
@@ -54,6 +52,8 @@ SPChessGame* spChessGameCreate(int historySize) {
 	game->whiteArmy->numOfRooks   = game->blackArmy->numOfRooks   = INIT_ROOKS;
 	game->whiteArmy->numOfQueens  = game->blackArmy->numOfQueens  = INIT_QUEENS;
 	game->status                  = GAME_NOT_FINISHED_NO_CHECK;
+	game->zobristKey              = computeZobristKey(game);
+	game->evaluation              = computeEvaluation(game);
 
 	return game;
 }
@@ -73,7 +73,7 @@ SPChessGame* spChessGameCopy(SPChessGame* src) {
 	if (src == NULL)
 		return NULL;
 
-	SPChessGame* dest = spChessGameCreate(src->history->maxSize);
+	SPChessGame* dest = spChessGameCreate();
 	if (dest == NULL)
 		return NULL;
 
@@ -82,6 +82,15 @@ SPChessGame* spChessGameCopy(SPChessGame* src) {
 		for (int col = 0; col < BOARD_LENGTH; col++)
 			dest->board[row][col] = src->board[row][col];
 
+	// copies the game bitboards
+	for (int player = 0; player < NUM_OF_PLAYERS; player++) {
+		for (int type = 0; type < NUM_OF_PIECE_TYPES; type++)
+			dest->pieces[player][type] = src->pieces[player][type];
+
+		dest->occupancy[player] = src->occupancy[player];
+	}
+	dest->allPieces               = src->allPieces;
+
 	dest->currentPlayer		      = src->currentPlayer;
 
 	dest->whiteKingRow			  = src->whiteKingRow;
@@ -107,6 +116,8 @@ SPChessGame* spChessGameCopy(SPChessGame* src) {
 	dest->blackArmy->numOfQueens  = src->blackArmy->numOfQueens;
 
 	dest->status				  = src->status;
+	dest->zobristKey              = src->zobristKey;
+	dest->evaluation              = src->evaluation;
 
 	return dest;
 }
@@ -123,7 +134,7 @@ void spChessGameDestroy(SPChessGame* game) {
 
 	free(game->blackArmy);
 	free(game->whiteArmy);
-	spArrayListDestroy(game->history);
+	spUndoStackDestroy(game->history);
 	free(game);
 }
 
@@ -174,7 +185,8 @@ SP_CHESS_GAME_MESSAGE spChessGamePrintBoard(SPChessGame* game) {
  *                                    and then if valid, setting the move by calling the helper function setCastleMove.
  * In case of a pawn promotion move - This case happens in this function only if it is a computer move, so its validity was
  * 									  already checked when as part of the Minimax algorithm. That's why in this case the function
- * 									  calls the spChessGameSetPawnPromotion.
+ * 									  calls the spChessGameSetPawnPromotion (or only the helper function setPawnPromotionMove
+ * 									  during the Minimax algorithm, that doesn't calculate the game status after a move).
  * 									  If the user tries to make a pawn promotion move, it first goes through this function as a
  * 									  regular move and after finish this function returns to the console manager while indicating
  * 									  pawn promotion is to be made.
@@ -217,6 +229,8 @@ SP_CHESS_GAME_MESSAGE spChessGameSetMove(SPChessGame* game, Move* move, bool min
 	if (!currentPlayerPiece(game->currentPlayer, move->srcPiece))
 		return SP_CHESS_GAME_INVALID_ARGUMENT;
 
+	GAME_STATUS statusBefore = game->status;
+
 	// saving the game castling indicators before the move is set (will serve us in the "undo" command)
 	move->whiteLeftCastle  = game->whiteLeftCastle;
 	move->whiteRightCastle = game->whiteRightCastle;
@@ -234,7 +248,9 @@ SP_CHESS_GAME_MESSAGE spChessGameSetMove(SPChessGame* game, Move* move, bool min
 		setCastleMove(game, move);
 	}
 	else if (move->pawnPromotion) {      // pawn promotion by the computer
-		if (spChessGameSetPawnPromotion(game, move, true) != SP_CHESS_GAME_SUCCESS)
+		if (minimaxMove)
+			setPawnPromotionMove(game, move, true);
+		else if (spChessGameSetPawnPromotion(game, move, true) != SP_CHESS_GAME_SUCCESS)
 			return SP_CHESS_GAME_MEMORY_FAILURE;
 	}
 	else {
@@ -245,7 +261,17 @@ SP_CHESS_GAME_MESSAGE spChessGameSetMove(SPChessGame* game, Move* move, bool min
 		setRegularMove(game, move);
 	}
 
-	return updatesAfterSettingMove(game, move, game->history, minimaxMove);
+	SP_CHESS_GAME_MESSAGE message = updatesAfterSettingMove(game, move, minimaxMove);
+	ZOBRIST_DEBUG_VERIFY(game);
+
+	/**
+	 * saving the move in the game history (during the Minimax algorithm we don't save the moves in the history, because an undo
+	 * is not executed there). A pawn promotion move of the user is saved once the user chooses the piece (see spChessGameSetPawnPromotion)
+	 */
+	if ((message == SP_CHESS_GAME_SUCCESS) && !minimaxMove && !(move->pawnPromotion && !computerMove))
+		message = spChessGameSaveMoveInHistory(game, move, statusBefore);
+
+	return message;
 }
 
 /**
@@ -254,34 +280,30 @@ SP_CHESS_GAME_MESSAGE spChessGameSetMove(SPChessGame* game, Move* move, bool min
  * A pawn promotion move by the user (either game mode 1 or 2) enters this function after first being set as a "regular move"
  * to the function spChessGameSetMove, and then after returning to the console manager - this function is called.
  * In addition, we update the relevant player's army.
+ * A pawn promotion move of the user is saved in the game history here, once the piece the pawn is promoted to is known
+ * (the game status before the move is still the current one, because it is updated only after the promotion).
  *
  * @param game         - A Chess game
  * @param move         - The pawn promotion move to be set in the game
  * @param computerMove - Indicates if it is a move done by the computer or not (i.e. by the user), might get true only on game mode 1
  *
  * @return
- * 		The SP_CHESS_GAME_MESSAGE that was returned from the function changePlayerAndUpdateStatus.
+ * 		SP_CHESS_GAME_MEMORY_FAILURE - If the move of the user couldn't be saved in the game history.
+ * 		Otherwise, the SP_CHESS_GAME_MESSAGE that was returned from the function changePlayerAndUpdateStatus.
  */
 SP_CHESS_GAME_MESSAGE spChessGameSetPawnPromotion(SPChessGame* game, Move* move, bool computerMove) {
-	char pawnType;
-	char piece = move->srcPiece;
+	GAME_STATUS statusBefore = game->status;
 
-	// updates position because didn't go through the "regular move route"
-	if (computerMove)
-		game->board[move->srcRow][move->srcCol] = EMPTY_POSITION;
+	// a computer move didn't go through the "regular move route", so its pawn is still at the source position
+	setPawnPromotionMove(game, move, computerMove);
 
-	pawnType = (game->currentPlayer == WHITE_PLAYER) ? WHITE_PAWN : BLACK_PAWN;
+	SP_CHESS_GAME_MESSAGE message = changePlayerAndUpdateStatus(game);
+	ZOBRIST_DEBUG_VERIFY(game);
 
-	// update the game board with the piece that the pawn was promoted to
-	game->board[move->dstRow][move->dstCol] = piece;
+	if ((message == SP_CHESS_GAME_SUCCESS) && !computerMove)
+		message = spChessGameSaveMoveInHistory(game, move, statusBefore);
 
-	// increasing the number of the piece replacing the pawn in the player's army (sending true means increasing)
-	updatePiecesAmount(game, move->srcPiece, true);
-
-	// decreasing the number of pawns in the player's army (sending false means decreasing)
-	updatePiecesAmount(game, pawnType, false);
-
-	return changePlayerAndUpdateStatus(game);
+	return message;
 }
 
 /**
@@ -298,88 +320,326 @@ SP_CHESS_GAME_MESSAGE spChessGameSetPawnPromotion(SPChessGame* game, Move* move,
  * 		True  - Otherwise.
  */
 bool spChessGameIsUndoPossible(SPChessGame* game, int userColor) {
-	return !(   (spArrayListIsEmpty(game->history))
-			 || ((userColor == BLACK_PLAYER) && (spArrayListSize(game->history) == ONLY_ONE_MOVE)));
+	int ply = spUndoStackPly(game->history);
+
+	return !((ply == 0) || ((userColor == BLACK_PLAYER) && (ply == ONLY_ONE_MOVE)));
+}
+
+/**
+ * The function checks if a "redo" command can be executed, i.e. if a move was undone and no other move was played since.
+ *
+ * @param game - A Chess game.
+ *
+ * @precondition - game is not NULL
+ *
+ * @return
+ * 		True if there is an undone move to redo, and false otherwise.
+ */
+bool spChessGameIsRedoPossible(SPChessGame* game) {
+	return (spUndoStackPly(game->history) < spUndoStackSize(game->history));
 }
 
 /**
  * The function removes from the game board the last chess move that was set.
- * In case of we remove a castle move, we update the board when calling the helper function undoCastleMove.
- * Otherwise, we remove we update the board in this function.
- * In addition, we update the castling indicators, the king position (if relevant, i.e.
- * if a king was involved in the move), the current player, the game status and the relevant player's army.
+ * The move is rebuilt from its entry in the game history (see spChessGameHistoryEntryToMove), and the board, the castling indicators,
+ * the king position (if relevant, i.e. if a king was involved in the move), the relevant player's army and the current player are
+ * recovered by the helper function undoSettingMove. The game status is recovered from the entry as well, and the current status is
+ * saved in the entry, for redoing the move.
  *
  * @param game - A Chess game
- * @param move - The last move that was set and should be removed
+ * @param move - The move to be filled with the removed move (for printing it), or NULL
  *
  * @return
- * 		SP_CHESS_GAME_INVALID_ARGUMENT - If game is NULL or move is NULL
+ * 		SP_CHESS_GAME_INVALID_ARGUMENT - If game is NULL or no move was played
  * 		SP_CHESS_GAME_SUCCESS          - Otherwise
  */
 SP_CHESS_GAME_MESSAGE spChessGameUndoPrevMove(SPChessGame* game, Move* move) {
-	if ((game == NULL) || (move == NULL))
+	if (game == NULL)
 		return SP_CHESS_GAME_INVALID_ARGUMENT;
 
-	// updating the game board
-	if (move->castleMove)
-		undoCastleMove(game, move);
-	else {
-		char originalSrcPiece;
+	UndoEntry* entry = spUndoStackUndo(game->history);
+	if (entry == NULL)
+		return SP_CHESS_GAME_INVALID_ARGUMENT;
 
-		if (move->pawnPromotion)
-			originalSrcPiece = ((!(game->currentPlayer)) == WHITE_PLAYER) ? WHITE_PAWN : BLACK_PAWN;
-		else
-			originalSrcPiece = move->srcPiece;
+	Move undoneMove;
+	spChessGameHistoryEntryToMove(game, entry, &undoneMove);
 
-		game->board[move->srcRow][move->srcCol] = originalSrcPiece;
-		game->board[move->dstRow][move->dstCol] = move->dstPiece;
-	}
+	undoSettingMove(game, &undoneMove);
+
+	entry->statusAfter = (unsigned char) game->status;
+	game->status       = (GAME_STATUS) entry->statusBefore;
+	ZOBRIST_DEBUG_VERIFY(game);
+
+	if (move != NULL)
+		spMoveCopyData(&undoneMove, move);
 
-	// recovering the castling indicatiors that were saved when the move was set
-	game->whiteLeftCastle  = move->whiteLeftCastle;
-	game->whiteRightCastle = move->whiteRightCastle;
-	game->blackLeftCastle  = move->blackLeftCastle;
-	game->blackRightCastle = move->blackRightCastle;
+	return SP_CHESS_GAME_SUCCESS;
+}
 
-	// recover the relevant king's position if it was moved
-	if (move->srcPiece == WHITE_KING) {
-		game->whiteKingRow = move->srcRow;
-		game->whiteKingCol = move->srcCol;
+/**
+ * The function sets again the last move that was undone (by spChessGameUndoPrevMove).
+ * The move is set as a computer move that is not saved again in the game history (it is still there), and the game status
+ * after the move is recovered from its entry, rather than being recalculated.
+ *
+ * @param game - A Chess game
+ * @param move - The move to be filled with the redone move (for printing it), or NULL
+ *
+ * @return
+ * 		SP_CHESS_GAME_INVALID_ARGUMENT - If game is NULL or there is no undone move
+ * 		SP_CHESS_GAME_SUCCESS          - If the move was set again
+ * 		Otherwise                      - The SP_CHESS_GAME_MESSAGE that was returned from spChessGameSetMove (the move is left
+ * 		                                  undone in the history, so the history still matches the board)
+ */
+SP_CHESS_GAME_MESSAGE spChessGameRedoMove(SPChessGame* game, Move* move) {
+	if (game == NULL)
+		return SP_CHESS_GAME_INVALID_ARGUMENT;
+
+	UndoEntry* entry = spUndoStackRedo(game->history);
+	if (entry == NULL)
+		return SP_CHESS_GAME_INVALID_ARGUMENT;
+
+	Move redoneMove;
+	spChessGameUnpackMove(game, entry->move, &redoneMove);
+
+	SP_CHESS_GAME_MESSAGE message = spChessGameSetMove(game, &redoneMove, true, true);
+	if (message != SP_CHESS_GAME_SUCCESS) {
+		spUndoStackUndo(game->history); // the move is undone again in the history, as it is on the board
+		return message;
 	}
-	else if (move->srcPiece == BLACK_KING) {
-		game->blackKingRow = move->srcRow;
-		game->blackKingCol = move->srcCol;
+
+	game->status = (GAME_STATUS) entry->statusAfter;
+
+	if (move != NULL)
+		spMoveCopyData(&redoneMove, move);
+
+	return SP_CHESS_GAME_SUCCESS;
+}
+
+/**
+ * The function moves the game to the given ply of its history (the position after the given number of moves since the game
+ * was created or loaded), by undoing the played moves or redoing the undone moves one by one.
+ *
+ * @param game - A Chess game
+ * @param ply  - The ply to jump to (between 0 and the number of the played and the undone moves)
+ *
+ * @return
+ * 		SP_CHESS_GAME_INVALID_ARGUMENT - If game is NULL or the ply is out of the history
+ * 		SP_CHESS_GAME_SUCCESS          - If the game was moved to the ply
+ * 		Otherwise                      - The SP_CHESS_GAME_MESSAGE of the first undo or redo that failed (the game is left at the
+ * 		                                  ply before that move, see spUndoStackPly)
+ */
+SP_CHESS_GAME_MESSAGE spChessGameJumpToPly(SPChessGame* game, int ply) {
+	if ((game == NULL) || (ply < 0) || (ply > spUndoStackSize(game->history)))
+		return SP_CHESS_GAME_INVALID_ARGUMENT;
+
+	SP_CHESS_GAME_MESSAGE message = SP_CHESS_GAME_SUCCESS;
+
+	while ((message == SP_CHESS_GAME_SUCCESS) && (spUndoStackPly(game->history) > ply))
+		message = spChessGameUndoPrevMove(game, NULL);
+
+	while ((message == SP_CHESS_GAME_SUCCESS) && (spUndoStackPly(game->history) < ply))
+		message = spChessGameRedoMove(game, NULL);
+
+	return message;
+}
+
+/**
+ * The function saves a move that was set in the game history, as a compact entry (see SPChessUndoStack): the packed move,
+ * the piece it captured, the castling indicators before it (saved in the move) and the game status before it.
+ *
+ * @param game         - A Chess game
+ * @param move         - The move that was set (for a pawn promotion move, its source piece is the piece the pawn was promoted to)
+ * @param statusBefore - The game status before the move
+ *
+ * @return
+ * 		SP_CHESS_GAME_MEMORY_FAILURE - If the history couldn't grow for the new entry.
+ * 		SP_CHESS_GAME_SUCCESS        - Otherwise.
+ */
+SP_CHESS_GAME_MESSAGE spChessGameSaveMoveInHistory(SPChessGame* game, Move* move, GAME_STATUS statusBefore) {
+	UndoEntry entry;
+
+	entry.move          = spChessGamePackMove(move);
+	entry.capturedPiece = (move->dstPieceCaptured) ? move->dstPiece : EMPTY_POSITION;
+	entry.castling      = (unsigned char) (  (move->whiteLeftCastle  ? UNDO_WHITE_LEFT_CASTLE  : 0)
+										   | (move->whiteRightCastle ? UNDO_WHITE_RIGHT_CASTLE : 0)
+										   | (move->blackLeftCastle  ? UNDO_BLACK_LEFT_CASTLE  : 0)
+										   | (move->blackRightCastle ? UNDO_BLACK_RIGHT_CASTLE : 0));
+	entry.statusBefore  = (unsigned char) statusBefore;
+	entry.statusAfter   = (unsigned char) game->status;
+
+	if (spUndoStackPush(game->history, &entry) != SP_UNDO_STACK_SUCCESS)
+		return SP_CHESS_GAME_MEMORY_FAILURE;
+
+	return SP_CHESS_GAME_SUCCESS;
+}
+
+/**
+ * The function rebuilds the last played move of the game from its entry in the game history, as a move that can be sent
+ * to undoSettingMove. The position is the position after the move, so the moved piece (or the piece a pawn was promoted to)
+ * is taken from the destination position, and the rook of a castle move from the player that made the move.
+ *
+ * @param game  - A Chess game
+ * @param entry - The history entry of the last played move
+ * @param move  - The move to be filled
+ */
+void spChessGameHistoryEntryToMove(SPChessGame* game, UndoEntry* entry, Move* move) {
+	int srcSquare = spPackedMoveSrc(entry->move);
+
+	move->srcRow              = SQUARE_ROW(srcSquare);
+	move->srcCol              = SQUARE_COL(srcSquare);
+	move->castleMove          = spPackedMoveIsCastle(entry->move);
+	move->pawnPromotion       = (spPackedMovePromotion(entry->move) != PAWN_TYPE);
+	move->dstPiece            = entry->capturedPiece;
+	move->dstPieceCaptured    = (entry->capturedPiece != EMPTY_POSITION);
+	move->threatenedAfterMove = false;
+	move->whiteLeftCastle     = ((entry->castling & UNDO_WHITE_LEFT_CASTLE)  != 0);
+	move->whiteRightCastle    = ((entry->castling & UNDO_WHITE_RIGHT_CASTLE) != 0);
+	move->blackLeftCastle     = ((entry->castling & UNDO_BLACK_LEFT_CASTLE)  != 0);
+	move->blackRightCastle    = ((entry->castling & UNDO_BLACK_RIGHT_CASTLE) != 0);
+
+	if (move->castleMove) {
+		// the rook of a castle move is next to the king's column, on the side it came from (see setCastleMove)
+		move->srcPiece = getPlayerPiece(!(game->currentPlayer), ROOK_TYPE);
+		move->dstRow   = move->srcRow;
+		move->dstCol   = (move->srcCol == LEFT_ROOK_COL) ? (KING_COL - 1) : (KING_COL + 1);
+		return;
 	}
 
-	spArrayListRemoveLast(game->history); // removing the last move from the game history
+	int dstSquare = spPackedMoveDst(entry->move);
+
+	move->dstRow   = SQUARE_ROW(dstSquare);
+	move->dstCol   = SQUARE_COL(dstSquare);
+	move->srcPiece = game->board[move->dstRow][move->dstCol];
+}
+
+/**
+ * The function applies a move in place as part of a search (i.e. the Minimax algorithm), so it can be reverted later
+ * with spChessGameUnmakeMove instead of copying the game for every move that is tried.
+ * The move is set as a computer move that is not saved in the game history (the moves of a search are generated as legal moves),
+ * and the given undo record keeps what the move itself doesn't keep for reverting it (the game status before the move).
+ * The game status is not calculated after the move (it is kept as it was before the move): calculating it means looking for a legal
+ * move of the next player, while the search generates all the moves of the next position anyway. The search sets the status of a
+ * position by itself when it generates its moves (a position without legal moves is a finished game).
+ *
+ * @param game - A Chess game
+ * @param move - A legal move of the current player (the move is updated while being set, and is needed for unmaking it)
+ * @param undo - The undo record to be filled, to be sent later to spChessGameUnmakeMove
+ *
+ * @return
+ * 		SP_CHESS_GAME_INVALID_ARGUMENT - If either game is NULL or move is NULL or undo is NULL.
+ * 		Otherwise, returns the SP_CHESS_GAME_MESSAGE that was returned from the function spChessGameSetMove.
+ */
+SP_CHESS_GAME_MESSAGE spChessGameMakeMove(SPChessGame* game, Move* move, UndoRecord* undo) {
+	if ((game == NULL) || (move == NULL) || (undo == NULL))
+		return SP_CHESS_GAME_INVALID_ARGUMENT;
+
+	undo->status = game->status;
 
-	// if not a castle and a piece was eaten - recounting the number of pieces for the "eaten" player
-	if (!(move->castleMove)) {
-		if (move->dstPieceCaptured)
-			updatePiecesAmount(game, move->dstPiece, true);
+	return spChessGameSetMove(game, move, true, true);
+}
 
-		if (move->pawnPromotion) {
-			updatePiecesAmount(game, move->srcPiece, false);
+/**
+ * The function reverts in place a move that was applied by spChessGameMakeMove (the last move that was made in the game).
+ * Unlike spChessGameUndoPrevMove, the game history is not changed and the game status is recovered from the
+ * undo record, rather than being recalculated.
+ *
+ * @param game - A Chess game
+ * @param move - The move that was sent to spChessGameMakeMove
+ * @param undo - The undo record that was filled by spChessGameMakeMove
+ */
+void spChessGameUnmakeMove(SPChessGame* game, Move* move, UndoRecord* undo) {
+	if ((game == NULL) || (move == NULL) || (undo == NULL))
+		return;
 
-			char pawnType = (game->currentPlayer == WHITE_PLAYER) ? WHITE_PAWN : BLACK_PAWN;
-			updatePiecesAmount(game, pawnType, true);
-		}
+	undoSettingMove(game, move);
+	game->status = undo->status;
+	ZOBRIST_DEBUG_VERIFY(game);
+}
+
+/**
+ * The function converts a move of the game to a packed move (see SPChessPackedMove).
+ *
+ * @param move - A move of the current position (for a pawn promotion move, its source piece is the piece the pawn is promoted to)
+ *
+ * @return
+ * 		The packed move.
+ */
+PackedMove spChessGamePackMove(Move* move) {
+	if (move->castleMove)
+		return spPackedMoveCreateCastle(POSITION_TO_SQUARE(move->srcRow, move->srcCol));
+
+	PIECE_TYPE promotionType = (move->pawnPromotion) ? getPieceType(move->srcPiece) : PAWN_TYPE;
+
+	return spPackedMoveCreate(POSITION_TO_SQUARE(move->srcRow, move->srcCol), POSITION_TO_SQUARE(move->dstRow, move->dstCol), promotionType);
+}
+
+/**
+ * The function converts a packed move of the current position to a move of the game, that can be set in the game (or sent to
+ * spChessGameMakeMove). The pieces of the move are taken from the board, and a pawn promotion move gets the piece of the current
+ * player that the pawn is promoted to as its source piece (as the pawn promotion moves of the computer). The move doesn't get the
+ * indicators that only inform the user (see updateMoveAnnotations).
+ *
+ * @param game       - A Chess game
+ * @param packedMove - A packed move of the current position (not NULL_PACKED_MOVE)
+ * @param move       - The move to be filled
+ */
+void spChessGameUnpackMove(SPChessGame* game, PackedMove packedMove, Move* move) {
+	int        srcSquare     = spPackedMoveSrc(packedMove);
+	PIECE_TYPE promotionType = spPackedMovePromotion(packedMove);
+
+	move->srcRow              = SQUARE_ROW(srcSquare);
+	move->srcCol              = SQUARE_COL(srcSquare);
+	move->srcPiece            = game->board[move->srcRow][move->srcCol];
+	move->castleMove          = spPackedMoveIsCastle(packedMove);
+	move->pawnPromotion       = (promotionType != PAWN_TYPE);
+	move->threatenedAfterMove = false;
+
+	if (move->castleMove) {
+		move->dstRow           = DUMMY_COORDINATE;
+		move->dstCol           = DUMMY_COORDINATE;
+		move->dstPiece         = EMPTY_POSITION;
+		move->dstPieceCaptured = false;
+		return;
 	}
 
-	// updating the cuurent player to be the opposite player
-	char currPlayer = game->currentPlayer = !(game->currentPlayer);
-	int kingRow = (currPlayer == WHITE_PLAYER) ? game->whiteKingRow : game->blackKingRow ;
-	int kingCol = (currPlayer == WHITE_PLAYER) ? game->whiteKingCol : game->blackKingCol ;
+	int dstSquare = spPackedMoveDst(packedMove);
 
-	// update the new game status (for sure iw was not finished before the removed move)
-	game->status = (rivalPlayerThreateningPosition(game, kingRow, kingCol)) ? GAME_NOT_FINISHED_CHECK : GAME_NOT_FINISHED_NO_CHECK;
+	move->dstRow           = SQUARE_ROW(dstSquare);
+	move->dstCol           = SQUARE_COL(dstSquare);
+	move->dstPiece         = game->board[move->dstRow][move->dstCol];
+	move->dstPieceCaptured = (move->dstPiece != EMPTY_POSITION);
 
-	return SP_CHESS_GAME_SUCCESS;
+	if (move->pawnPromotion)
+		move->srcPiece = getPlayerPiece(game->currentPlayer, promotionType);
+}
+
+/**
+ * The function verifies that the Zobrist key and the evaluation of the game, that are updated incrementally with every change of
+ * the game, match the ones that are computed from scratch for the current position. It is called after every change of the game
+ * only in a debug build (see ZOBRIST_DEBUG_VERIFY), and stops the program on the first mismatch.
+ *
+ * @param game         - A Chess game
+ * @param functionName - The name of the function that changed the game (printed on a mismatch)
+ */
+void spChessGameVerifyZobristKey(SPChessGame* game, const char* functionName) {
+	if (game->zobristKey != computeZobristKey(game)) {
+		fprintf(stderr, ZOBRIST_MISMATCH_ERROR, functionName);
+		abort();
+	}
+
+	Evaluation evaluation = computeEvaluation(game);
+
+	if (   (game->evaluation.midgameScore != evaluation.midgameScore) || (game->evaluation.endgameScore != evaluation.endgameScore)
+		|| (game->evaluation.phase != evaluation.phase)) {
+		fprintf(stderr, EVALUATION_MISMATCH_ERROR, functionName);
+		abort();
+	}
 }
 
 /**
  * The function sets the possible moves for the piece that is located in a given position on board.
- * For doing so, the function calls to the helper function getPossiblePieceMoves.
+ * For doing so, the function calculates the legality masks of the current position (by calling the helper function
+ * getLegalityMasks), and then calls to the helper function getPossiblePieceMoves.
  *
  * @param game               - A Chess game
  * @param piecePossibleMoves - The array list that will be filled with possible moves by the relevant piece
@@ -405,7 +665,10 @@ SP_CHESS_GAME_MESSAGE spChessGetPossibleMoves(SPChessGame* game, SPArrayList* pi
 	if (!currentPlayerPiece(game->currentPlayer, pieceType))
 		return SP_CHESS_GAME_INVALID_ARGUMENT;
 
-	/* True is sent at the 6th parameter so the moves will get sorted.
+	LegalityMasks masks;
+	getLegalityMasks(game, &masks);
+
+	/* The moves are returned already sorted.
 	   False is sent at the last parameter function is not called from the Minimax algorithm */
-	return getPossiblePieceMoves(game, piecePossibleMoves, row, col, pieceType, true, false);
+	return getPossiblePieceMoves(game, piecePossibleMoves, row, col, pieceType, &masks, false);
 }
@@ -44,306 +44,480 @@ void initializeBoard(char board[][BOARD_LENGTH]) {
 }
 
 /**
- * The function checks the legality of a "regular" move (not a castle move, which has its own function for checking its legality).
- * The technique used for checking the move legality is terms of game logic is:
- * First, we verify that the piece to be moved from the source position is trying to do so without violating the Chess rules for its
- * specific movement rules by calling to the helper function legalMovementByPieceType (each type in chess has its own legal movement rules).
- * Second, we set the move (i.e. updating the game board as if the move was set) and then use the helper function rivalPlayerThreateningPosition
- * to see if the player puts himslef under "check" by executing this move (which is of course illegal according to Chess rules).
- * At the end, the game board is restored to the state it was before entering this function.
+ * The function initializes the bitboards of A Chess game according to its game board.
+ * Every non empty position on the board sets its bit in the bitboard of the piece's type and color, in the occupancy
+ * bitboard of the piece's player and in the bitboard of all the pieces.
+ * It is used whenever the game board is filled directly (when the game is created and when a game is loaded from a file).
+ *
+ * @param game - A Chess game
+ */
+void initializeBitboards(SPChessGame* game) {
+	for (int player = 0; player < NUM_OF_PLAYERS; player++) {
+		for (int type = 0; type < NUM_OF_PIECE_TYPES; type++)
+			game->pieces[player][type] = EMPTY_BITBOARD;
+
+		game->occupancy[player] = EMPTY_BITBOARD;
+	}
+	game->allPieces = EMPTY_BITBOARD;
+
+	for (int row = 0; row < BOARD_LENGTH; row++) {
+		for (int col = 0; col < BOARD_LENGTH; col++) {
+			char piece = game->board[row][col];
+			if (piece == EMPTY_POSITION)
+				continue;
+
+			Bitboard position = SQUARE_BITBOARD(POSITION_TO_SQUARE(row, col));
+			int      player   = pieceOwner(piece);
+
+			game->pieces[player][getPieceType(piece)] |= position;
+			game->occupancy[player]                   |= position;
+			game->allPieces                           |= position;
+		}
+	}
+}
+
+/**
+ * The function computes from scratch the Zobrist key of the current position of the game: the keys of all the pieces on board,
+ * the key of the black player's turn (if it's his turn) and the keys of the castling indicators that are still available.
+ * During a game the key is updated incrementally, so this is needed only when the game board is filled directly
+ * (when the game is created and when a game is loaded from a file) and for verifying the incremental updates.
  *
  * @param game - A Chess game
- * @param move - The move to be set in the game
  *
  * @return
- * 		True  - If the move that was received as a parameter is legal.
- * 		False - Otherwise.
+ * 		The Zobrist key of the game position.
  */
-bool legalRegularMove(SPChessGame* game, Move* move) {
-	char srcPiece   = move->srcPiece;
-	int  currPlayer = game->currentPlayer;
-	bool isLegal    = false; // initializes a default value
+ZobristKey computeZobristKey(SPChessGame* game) {
+	ZobristKey key = gameCastlingKey(game);
 
-	// updating the destination piece of the move in this function because its legality needs to be checked
-	char dstPiece = move->dstPiece = game->board[move->dstRow][move->dstCol];
+	if (game->currentPlayer == BLACK_PLAYER)
+		key ^= spZobristSideKey();
 
-	// this condition also covers the check that the source position and destination position are not equal
-	if (currentPlayerPiece(currPlayer, dstPiece))
-		return false;
+	for (int player = 0; player < NUM_OF_PLAYERS; player++) {
+		for (int type = 0; type < NUM_OF_PIECE_TYPES; type++) {
+			Bitboard pieces = game->pieces[player][type];
 
-	if (!legalMovementByPieceType(game, move))
-		return false;
+			while (pieces != EMPTY_BITBOARD)
+				key ^= spZobristPieceKey(player, type, spBitboardPopFirstSquare(&pieces));
+		}
+	}
 
-	if (dstPiece != EMPTY_POSITION)
-		move->dstPieceCaptured = true; // updating this indicator for the use of get_moves command by the user
+	return key;
+}
+
+/**
+ * The function computes from scratch the evaluation accumulator of the current position of the game (the scores of all the pieces
+ * on board and the game phase, see SPChessEvaluation). Like the Zobrist key, the accumulator is updated incrementally during a game,
+ * so this is needed only when the game board is filled directly and for verifying the incremental updates.
+ *
+ * @param game - A Chess game
+ *
+ * @return
+ * 		The evaluation accumulator of the game position.
+ */
+Evaluation computeEvaluation(SPChessGame* game) {
+	Evaluation evaluation;
+	spEvaluationClear(&evaluation);
 
-	// update the board as if the move is executed.
-	// We don't bother taking pawn promotion into consideration since this is irrelevant for the check legality test
-	// (promoting a pawn of the current player that makes the move shouldn't cause the king of the current player be under check).
-	game->board[move->srcRow][move->srcCol] = EMPTY_POSITION;
-	game->board[move->dstRow][move->dstCol] = srcPiece;
+	for (int player = 0; player < NUM_OF_PLAYERS; player++) {
+		for (int type = 0; type < NUM_OF_PIECE_TYPES; type++) {
+			Bitboard pieces = game->pieces[player][type];
 
-	if ((srcPiece == WHITE_KING) || (srcPiece == BLACK_KING))
-		isLegal = !rivalPlayerThreateningPosition(game, move->dstRow, move->dstCol); // sending new king's position
-	else {
-		int kingRow = (currPlayer == WHITE_PLAYER) ? game->whiteKingRow : game->blackKingRow;
-		int kingCol = (currPlayer == WHITE_PLAYER) ? game->whiteKingCol : game->blackKingCol;
-		isLegal = !rivalPlayerThreateningPosition(game, kingRow, kingCol);           // sending current king's position
+			while (pieces != EMPTY_BITBOARD)
+				spEvaluationAddPiece(&evaluation, (player == WHITE_PLAYER), type, spBitboardPopFirstSquare(&pieces));
+		}
+	}
+
+	return evaluation;
+}
+
+/**
+ * The function returns the combined Zobrist key of the current castling indicators of the game.
+ *
+ * @param game - A Chess game
+ *
+ * @return
+ * 		The combined key of the game castling indicators.
+ */
+ZobristKey gameCastlingKey(SPChessGame* game) {
+	return spZobristCastlingKey(game->whiteLeftCastle, game->whiteRightCastle, game->blackLeftCastle, game->blackRightCastle);
+}
 
-		if (isLegal) {
-			// updating this indicator for the use of get_moves command by the user
-			move->threatenedAfterMove = rivalPlayerThreateningPosition(game, move->dstRow, move->dstCol);
+/**
+ * The function sets the given game to a given position: the board, the kings positions, the armies, the player that is
+ * its turn to play and the castling indicators. The bitboards, the Zobrist key, the evaluation and the game status are built from them.
+ * It is used by the tools that run on fixed positions (see SPChessPerft and SPChessBench).
+ *
+ * @param game             - A Chess game
+ * @param rows             - The rows of the board, from the 8th row down to the 1st row (as in a saved game file)
+ * @param currentPlayer    - The player that is its turn to play
+ * @param whiteLeftCastle  - The castling indicators of the position
+ * @param whiteRightCastle
+ * @param blackLeftCastle
+ * @param blackRightCastle
+ *
+ * @precondition - Every player has exactly one king on the rows, and the position is a legal position.
+ */
+void setGamePosition(SPChessGame* game, const char* const rows[], int currentPlayer, bool whiteLeftCastle, bool whiteRightCastle, bool blackLeftCastle, bool blackRightCastle) {
+	nullifyArmies(game);
 
-			if (   ((currPlayer == WHITE_PLAYER) && (move->srcPiece == WHITE_PAWN) && (move->dstRow == BLACK_FIRST_ROW))
-				|| ((currPlayer == BLACK_PLAYER) && (move->srcPiece == BLACK_PAWN) && (move->dstRow == WHITE_FIRST_ROW))) {
+	for (int row = 0; row < BOARD_LENGTH; row++) {
+		for (int col = 0; col < BOARD_LENGTH; col++) {
+			char piece = rows[BOARD_LENGTH - 1 - row][col];
+			game->board[row][col] = piece;
 
-						move->pawnPromotion = true; // helps us informing the user a "pawn promotion" occured
+			if (piece == WHITE_KING) {
+				game->whiteKingRow = row;
+				game->whiteKingCol = col;
 			}
+			else if (piece == BLACK_KING) {
+				game->blackKingRow = row;
+				game->blackKingCol = col;
+			}
+			else if (piece != EMPTY_POSITION)
+				updatePiecesAmount(game, piece, true);
 		}
 	}
 
-	// Restore the board to its original state
-	game->board[move->srcRow][move->srcCol] = srcPiece;
-	game->board[move->dstRow][move->dstCol] = dstPiece;
+	game->currentPlayer    = (char) currentPlayer;
+	game->whiteLeftCastle  = whiteLeftCastle;
+	game->whiteRightCastle = whiteRightCastle;
+	game->blackLeftCastle  = blackLeftCastle;
+	game->blackRightCastle = blackRightCastle;
+
+	initializeBitboards(game);
+	game->zobristKey = computeZobristKey(game);
+	game->evaluation = computeEvaluation(game);
+	game->status     = (game->currentPlayer == WHITE_PLAYER) ? getGameStatus(game, game->whiteKingRow, game->whiteKingCol)
+															 : getGameStatus(game, game->blackKingRow, game->blackKingCol);
+}
 
-	return isLegal;
+/**
+ * The function places the given piece at the given position, replacing the piece that occupied it (if there was one).
+ * Together with removePiece, this is the only way a position changes during a game, so the game board,
+ * the bitboards of the game, the game Zobrist key and the game evaluation are always kept in sync.
+ *
+ * @param game  - A Chess game
+ * @param row   - The row of the position
+ * @param col   - The column of the position
+ * @param piece - The piece to place at the position (EMPTY_POSITION only empties the position)
+ */
+void placePiece(SPChessGame* game, int row, int col, char piece) {
+	removePiece(game, row, col);
+
+	if (piece == EMPTY_POSITION)
+		return;
+
+	int        square   = POSITION_TO_SQUARE(row, col);
+	Bitboard   position = SQUARE_BITBOARD(square);
+	int        player   = pieceOwner(piece);
+	PIECE_TYPE type     = getPieceType(piece);
+
+	game->pieces[player][type] |= position;
+	game->occupancy[player]    |= position;
+	game->allPieces            |= position;
+	game->zobristKey           ^= spZobristPieceKey(player, type, square);
+	game->board[row][col]       = piece;
+	spEvaluationAddPiece(&(game->evaluation), (player == WHITE_PLAYER), type, square);
 }
 
 /**
- * The function calls the relevant helper function, according to the type of the piece to be moved from the source position,
- * to check if that piece is about to move without violating its specicfic Chess rules for movement on board.
- * The bishop, rook and queen are the only ones that can move towards a route - because of that, in order to check the legality
- * of their movement there is a special helper function that takes advantage of the similarities in their movement.
+ * The function removes the piece that occupies the given position (if there is one), from the game board,
+ * the bitboards of the game, the game Zobrist key and the game evaluation.
+ *
+ * @param game - A Chess game
+ * @param row  - The row of the position
+ * @param col  - The column of the position
+ */
+void removePiece(SPChessGame* game, int row, int col) {
+	char piece = game->board[row][col];
+	if (piece == EMPTY_POSITION)
+		return;
+
+	int        square = POSITION_TO_SQUARE(row, col);
+	Bitboard   mask   = ~SQUARE_BITBOARD(square);
+	int        player = pieceOwner(piece);
+	PIECE_TYPE type   = getPieceType(piece);
+
+	game->pieces[player][type] &= mask;
+	game->occupancy[player]    &= mask;
+	game->allPieces            &= mask;
+	game->zobristKey           ^= spZobristPieceKey(player, type, square);
+	game->board[row][col]       = EMPTY_POSITION;
+	spEvaluationRemovePiece(&(game->evaluation), (player == WHITE_PLAYER), type, square);
+}
+
+/**
+ * The function checks the legality of a "regular" move (not a castle move, which has its own function for checking its legality).
+ * The technique used for checking the move legality is terms of game logic is:
+ * First, we calculate the legality masks of the current position (the "check" and "pinned pieces" masks) by calling the helper
+ * function getLegalityMasks.
+ * Then, we verify that the destination position is set in the bitboard of the legal positions the piece can move to (calculated by
+ * the helper function getLegalPieceMovesBitboard) - i.e. the piece doesn't violate its specific movement rules, and the player doesn't
+ * put himslef under "check" by executing this move (which is of course illegal according to Chess rules).
+ * The game itself is not changed while checking that.
  *
  * @param game - A Chess game
  * @param move - The move to be set in the game
  *
  * @return
- * 		True  - If the movement by the piece is legal.
+ * 		True  - If the move that was received as a parameter is legal.
  * 		False - Otherwise.
  */
-bool legalMovementByPieceType(SPChessGame* game, Move* move) {
-	switch (move->srcPiece) {
-		case WHITE_PAWN:
-		case BLACK_PAWN:
-			return legalMovementByPawn(game->board, move, game->currentPlayer);
+bool legalRegularMove(SPChessGame* game, Move* move) {
+	// updating the destination piece of the move in this function because its legality needs to be checked
+	char dstPiece = move->dstPiece = game->board[move->dstRow][move->dstCol];
 
-		case WHITE_KNIGHT:
-		case BLACK_KNIGHT:
-			return legalMovementByKnight(move);
+	// this condition also covers the check that the source position and destination position are not equal
+	if (currentPlayerPiece(game->currentPlayer, dstPiece))
+		return false;
 
-		case WHITE_BISHOP:
-		case BLACK_BISHOP:
-		case WHITE_ROOK:
-		case BLACK_ROOK:
-		case WHITE_QUEEN:
-		case BLACK_QUEEN:
-			return legalMovementByBishopRookQueen(game->board, move);
+	LegalityMasks masks;
+	getLegalityMasks(game, &masks);
 
-		case WHITE_KING:
-		case BLACK_KING:
-			return legalMovementByKing(move);
+	Bitboard dstPosition = SQUARE_BITBOARD(POSITION_TO_SQUARE(move->dstRow, move->dstCol));
+	if (!(getLegalPieceMovesBitboard(game, move->srcRow, move->srcCol, move->srcPiece, &masks) & dstPosition))
+		return false;
 
-		default:
-			return false;
-	}
+	if (dstPiece != EMPTY_POSITION)
+		move->dstPieceCaptured = true; // updating this indicator for the use of get_moves command by the user
+
+	updateMoveIndicators(game, move);
+
+	return true;
 }
 
 /**
- * The function checks if the movement of the pawn in the given move is legal according to Chess rules.
- * Pawn movement is special because of the fact that it is the only piece on board that cannot "eat" in the same direction that
- * it can move to an empty position ("eating" is diagonally, advancing to an empty position is by moving straight).
- *
- * @param board      - The current game board
- * @param move       - The move to be set with the pawn
- * @param currPlayer - The player that is trying to set the move
- *
- * @return
- * 		True  - If the movement by the pawn is legal.
- * 		False - Otherwise.
+ * The function calculates the legality masks of the current position, once for all the moves of the current player:
+ * 1) The "check" mask - the positions that a piece other than the king may move to. If the player is not under "check" every position
+ *     is allowed. If a single rival piece threatens the king, the piece must either "eat" it or block its route to the king. If two rival
+ *     pieces threaten the king, only the king itself can move.
+ * 2) The pinned pieces - the pieces of the player that are the only piece between the king and a rival bishop/rook/queen, so
+ *     they can only move along the line that passes through the king and themselves.
+ *
+ * @param game  - A Chess game
+ * @param masks - The legality masks to be filled
  */
-bool legalMovementByPawn(char board[][BOARD_LENGTH], Move* move, int currPlayer) {
-	int srcRow    = move->srcRow;
-	int dstRow    = move->dstRow;
-	int srcCol    = move->srcCol;
-	int dstCol    = move->dstCol;
-	char dstPiece = move->dstPiece;
-
-	return !(    // white pawn cannot adavance more than 1 row upwards (can adavance 2 only if it is its first move)
-				(   (currPlayer == WHITE_PLAYER)
-			     && (dstRow != (srcRow + 1))
-				 && !((dstRow == (srcRow + 2)) && (srcRow == WHITE_PAWNS_ROW) && (dstCol == srcCol) && (board[srcRow + 1][dstCol] == EMPTY_POSITION)))
-
-				 // black pawn cannot adavance more than 1 row downwards (can adavance 2 only if it is its first move)
-			 || (   (currPlayer == BLACK_PLAYER)
-			     && (dstRow != (srcRow - 1))
-			     && !((dstRow == (srcRow - 2)) && (srcRow == BLACK_PAWNS_ROW) && (dstCol == srcCol) && (board[srcRow - 1][dstCol] == EMPTY_POSITION)))
-
-			     // a pawn cannot move (if either "eating" a rival piece or if not) more than 1 column to the left/right
-			 || (   (dstCol < (srcCol - 1))
-				 || (dstCol > (srcCol + 1)))
-
-				 // a pawn cannot advance straight if it is "blocked" by another piece
-			 || (   (dstCol == srcCol)
-				 && (dstPiece != EMPTY_POSITION))
-
-				 // a pawn cannot advance diagonally if it is not for "eating" a rival piece
-			 || (   (dstCol != srcCol)
-				 && !rivalPiece(currPlayer, dstPiece)));
+void getLegalityMasks(SPChessGame* game, LegalityMasks* masks) {
+	int currPlayer = game->currentPlayer;
+	int rival      = !currPlayer;
+	int kingRow    = (currPlayer == WHITE_PLAYER) ? game->whiteKingRow : game->blackKingRow;
+	int kingCol    = (currPlayer == WHITE_PLAYER) ? game->whiteKingCol : game->blackKingCol;
+	int kingSquare = POSITION_TO_SQUARE(kingRow, kingCol);
+
+	Bitboard* rivalPieces = game->pieces[rival];
+	Bitboard  checkers    = squareAttackers(game, kingSquare, rival, game->allPieces);
+
+	// the rival bishops/rooks/queens that would threaten the king on an empty board
+	Bitboard  snipers     = (  (spBitboardRookAttacks(kingSquare, EMPTY_BITBOARD)   & (rivalPieces[ROOK_TYPE]   | rivalPieces[QUEEN_TYPE]))
+						     | (spBitboardBishopAttacks(kingSquare, EMPTY_BITBOARD) & (rivalPieces[BISHOP_TYPE] | rivalPieces[QUEEN_TYPE])));
+
+	masks->kingSquare   = kingSquare;
+	masks->pinnedPieces = EMPTY_BITBOARD;
+
+	while (snipers != EMPTY_BITBOARD) {
+		Bitboard blockers = (spBitboardBetween(kingSquare, spBitboardPopFirstSquare(&snipers)) & game->allPieces);
+
+		// a single piece of the current player between the king and the sniper is pinned
+		if (spBitboardCountSquares(blockers) == 1)
+			masks->pinnedPieces |= (blockers & game->occupancy[currPlayer]);
+	}
+
+	if (checkers == EMPTY_BITBOARD)
+		masks->checkMask = FULL_BITBOARD;
+	else if (spBitboardCountSquares(checkers) == 1)
+		masks->checkMask = (checkers | spBitboardBetween(kingSquare, spBitboardFirstSquare(checkers)));
+	else
+		masks->checkMask = EMPTY_BITBOARD;
 }
 
 /**
- * The function checks if the movement of the knight in the given move is legal according to Chess rules.
- * In general, the knight can move in an "L" shape to 8 different postions respectively to where it is located (even though
- * not always all of the 8 positions are possible in terms of their presence on board).
- * What is common to all of these 8 moves are the facts that the knight cannot move more than 2 rows/columns upwards/downwards,
- * and that's why in the function we calculate the absolute distances between the knight's row/column at the source position and
- * the knight's row/column at the destination position.
+ * The function calculates the positions that the piece in the given position can legally move to (not including castle moves).
+ * For every piece except the king, the positions that are returned from getPieceMovesBitboard are filtered by the legality masks of
+ * the position, without testing every move. Only the king's moves are tested one by one with the helper function kingSafeAfterMovement
+ * (the king might step into a position that is threatened only once the king leaves its current position).
  *
- * @param move - The move to be set with the knight
+ * @param game   - A Chess game
+ * @param srcRow - The row of the given piece's position
+ * @param srcCol - The column of the given piece's position
+ * @param piece  - The piece in the given position (belongs to the current player)
+ * @param masks  - The legality masks of the current position (filled by getLegalityMasks)
  *
  * @return
- * 		True  - If the movement by the knight is legal (movement the creates "L" shape)
- * 		False - Otherwise.
+ * 		A bitboard of all the positions that the piece can legally move to.
  */
-bool legalMovementByKnight(Move* move) {
-	int rowDifference = abs(move->dstRow - move->srcRow);
-	int colDifference = abs(move->dstCol - move->srcCol);
-
-	return !(   ((rowDifference != 1) && (rowDifference != 2))   // knight cannot move more then 2 rows upwards/downwards
-			 ||	((colDifference != 1) && (colDifference != 2))   // knight cannot move more then 2 columns upwards/downwards
-			 || ((rowDifference == 1) && (colDifference != 2))   // if knight moved 1 row upwards/downwards - it must move 2 columns sidewards
-			 || ((rowDifference == 2) && (colDifference != 1))); // if knight moved 2 rows upwards/downwards - it must move 1 column sidewards
+Bitboard getLegalPieceMovesBitboard(SPChessGame* game, int srcRow, int srcCol, char piece, const LegalityMasks* masks) {
+	int      srcSquare  = POSITION_TO_SQUARE(srcRow, srcCol);
+	Bitboard pieceMoves = getPieceMovesBitboard(game, srcRow, srcCol, piece);
+
+	if (srcSquare == masks->kingSquare) {
+		Bitboard legalMoves = EMPTY_BITBOARD;
+
+		while (pieceMoves != EMPTY_BITBOARD) {
+			int dstSquare = spBitboardPopFirstSquare(&pieceMoves);
+
+			if (kingSafeAfterMovement(game, srcSquare, dstSquare))
+				legalMoves |= SQUARE_BITBOARD(dstSquare);
+		}
+
+		return legalMoves;
+	}
+
+	pieceMoves &= masks->checkMask;
+
+	if (masks->pinnedPieces & SQUARE_BITBOARD(srcSquare))
+		pieceMoves &= spBitboardLine(masks->kingSquare, srcSquare);
+
+	return pieceMoves;
 }
 
 /**
- * The function checks if the movement of the bishop/rook/queen in the given move is legal according to Chess rules.
- * The bishop, rook and queen are the only ones that can move towards a route - and this function is meant to take
- * advantage of the similarities in their movement.
- * In addition, the queen's movement is said to be the union of the bishop's and the rook's movements:
- * The bishop can only move diagonally on the board to each of in each of the four possible
- * directions, while the rook can only move a straight way in each of the four possible
- * directions (either horizontally ot vertically).
- * The function determines a delta row and delta column variables that represent the change between two sequential positions in
- * the direction the piece is trying to reach in the given move. These two variables will be sent to the helper function vacantRouteToDst
- * that will check the actual movement legality of the piece in the given move (i.e. that the route to the destination position is vacant).
- *
- * @param board - The current game board
- * @param move  - The move to be set with the either bishop, the rook of the queen
+ * The function calculates the positions that the piece in the given position can move to according to its specific movement
+ * rules, regardless of the safety of the king (i.e. the returned positions might still put the player under "check").
+ * A piece cannot move to a position that is occupied by a piece of the same player, and the bishop, rook and queen
+ * cannot "jump" over other pieces (which is handled by sending the occupancy of the board to their attacks functions).
+ *
+ * @param game   - A Chess game
+ * @param srcRow - The row of the given piece's position
+ * @param srcCol - The column of the given piece's position
+ * @param piece  - The piece in the given position (belongs to the current player)
  *
  * @return
- * 		True  - If the movement by the bishop/rook/queen is legal (i.e. the route to the destination position is vacant and
- * 		         the destination position is not occupied by a piece that belongs to the same player).
- * 		False - Otherwise.
+ * 		A bitboard of all the positions that the piece can move to.
  */
-bool legalMovementByBishopRookQueen(char board[][BOARD_LENGTH], Move* move) {
-	int srcRow = move->srcRow, srcCol = move->srcCol, dstRow = move->dstRow, dstCol = move->dstCol;
-	int srcPiece = board[srcRow][srcCol];
-	int rowDifference = abs(dstRow - srcRow); // the absolute value of the distance between the source row and the destination row
-	int colDifference = abs(dstCol - srcCol); // the absolute value of the distance between the source column and the destination column
-	int deltaRow, deltaCol;
+Bitboard getPieceMovesBitboard(SPChessGame* game, int srcRow, int srcCol, char piece) {
+	int      square    = POSITION_TO_SQUARE(srcRow, srcCol);
+	Bitboard occupancy = game->allPieces;
+	Bitboard moves;
 
-	switch (srcPiece) {
-		case WHITE_BISHOP:
-		case BLACK_BISHOP:
-			if (rowDifference != colDifference) // should always be equal on a bishop movement (diagonal movement)
-				return false;
+	switch (getPieceType(piece)) {
+		case PAWN_TYPE:
+			return getPawnMovesBitboard(game, square);
 
-			deltaRow = (dstRow > srcRow) ? 1 : (-1); // gets 1 for moving right in the diagonal, -1 for moving left in the diagonal
-			deltaCol = (dstCol > srcCol) ? 1 : (-1); // gets 1 for moving up in the diagonal, -1 for moving down in the diagonal
+		case KNIGHT_TYPE:
+			moves = spBitboardKnightAttacks(square);
 			break;
-		case WHITE_ROOK:
-		case BLACK_ROOK:
-			if ((srcRow != dstRow) && (srcCol != dstCol)) // should always end it's movement either on the same row or on the same column
-				return false;
 
-			if (dstRow == srcRow) {
-				deltaRow = 0;
-				deltaCol = (dstCol > srcCol) ? 1 : (-1); // gets 1 if the movements is to the right, -1 if the movement is to the left
-			}
-			else {
-				deltaCol = 0;
-				deltaRow = (dstRow > srcRow) ? 1 : (-1); // gets 1 if the movements is upwards, -1 if the movement is downwards
-			}
+		case BISHOP_TYPE:
+			moves = spBitboardBishopAttacks(square, occupancy);
 			break;
-		case WHITE_QUEEN:
-		case BLACK_QUEEN:
-			if (rowDifference == colDifference) {        // in case the queen moves similar to a bishop's movement
-				deltaRow = (dstRow > srcRow) ? 1 : (-1);
-				deltaCol = (dstCol > srcCol) ? 1 : (-1);
-			}
-			// illegal move if the movement by the queen is not similar to a bishop's movement nor similar to a rook's movement
-			else if ((srcRow != dstRow) && (srcCol != dstCol))
-				return false;
-			else {                                       // in case the queen moves similar to a rooks's movement
-				if (dstRow == srcRow) {
-					deltaRow = 0;
-					deltaCol = (dstCol > srcCol) ? 1 : (-1);
-				}
-				else {
-					deltaCol = 0;
-					deltaRow = (dstRow > srcRow) ? 1 : (-1);
-				}
-			}
+
+		case ROOK_TYPE:
+			moves = spBitboardRookAttacks(square, occupancy);
+			break;
+
+		case QUEEN_TYPE:
+			moves = spBitboardQueenAttacks(square, occupancy);
 			break;
+
+		case KING_TYPE:
+			moves = spBitboardKingAttacks(square);
+			break;
+
 		default:
-			return false;
+			return EMPTY_BITBOARD;
 	}
 
-	return (vacantRouteToDst(board, move, deltaRow, deltaCol));
+	return (moves & ~(game->occupancy[(int) game->currentPlayer]));
 }
 
 /**
- * The function checks if the route from the source position to the destination position is vacant,
- * doing so by using its parameters deltaRow and daltaCol that indicate in which directions the route to the destination position is.
+ * The function calculates the positions that the pawn of the current player in the given square can move to:
+ * 1) Advancing one row (upwards for the white player, downwards for the black player) if that position is empty.
+ * 2) Advancing two rows if it is the pawn's first move and both of the positions in front of it are empty.
+ * 3) "Eating" diagonally, only if a rival piece occupies the position.
  *
- * @param board    - The current game board
- * @param move     - The move to be set with the either bishop, the rook of the queen
- * @param deltaRow - The direction of the checked route in terms of up/down (equals 1 for up, -1 for down and 0 for staying at the same row)
- * @param deltaCol - The direction of the checked route in terms of up/down (equals 1 for right, -1 for left and 0 for staying at the same column)
+ * @param game   - A Chess game
+ * @param square - The square of the pawn
  *
  * @return
- * 		True  - If route from the source position to the destination position is vacant.
- * 		False - Otherwise.
+ * 		A bitboard of all the positions that the pawn can move to.
  */
-bool vacantRouteToDst(char board[][BOARD_LENGTH], Move* move, int deltaRow, int deltaCol) {
-	int rowToCheck = move->srcRow;
-	int colToCheck = move->srcCol;
-	int dstRow = move->dstRow;
-	int dstCol = move->dstCol;
-	bool reachedDest;
-
-	/* We advance along the direction, advancing by deltaRow,deltaCol in each iteration.
-	   We will stop once we no longer hit an empty position or when we reached the destination position. */
-	do {
-		rowToCheck += deltaRow;
-		colToCheck += deltaCol;
-		reachedDest = ((rowToCheck == dstRow) && (colToCheck == dstCol));
-	} while (!reachedDest && (board[rowToCheck][colToCheck] == EMPTY_POSITION));
-
-	return reachedDest;
+Bitboard getPawnMovesBitboard(SPChessGame* game, int square) {
+	int       currPlayer = game->currentPlayer;
+	bool      whitePawn  = (currPlayer == WHITE_PLAYER);
+	DIRECTION forwards   = (whitePawn) ? DIRECTION_UP    : DIRECTION_DOWN;
+	int       pawnsRow   = (whitePawn) ? WHITE_PAWNS_ROW : BLACK_PAWNS_ROW;
+	Bitboard  empty      = ~(game->allPieces);
+
+	Bitboard moves = (spBitboardShift(SQUARE_BITBOARD(square), forwards) & empty);
+
+	// moving two rows is possible only from the pawns row, and only if the first position in front of the pawn is empty
+	if (SQUARE_ROW(square) == pawnsRow)
+		moves |= (spBitboardShift(moves, forwards) & empty);
+
+	return (moves | (spBitboardPawnAttacks(whitePawn, square) & game->occupancy[!currPlayer]));
 }
 
 /**
- * The function checks if the movement of the knight in the given move is legal according to Chess rules.
- * In general, the knig can move to 8 different postions respectively to where it is located (even though not always
- * all of the 8 positions are possible in terms of their presence on board).
- * These 8 positions are all the positions on board that are 1 square away from the king's position (i.e. 1 step
- * upwards/downwards/to the left/to the right/diagonally).
- * For that reason, to verify the legality of the move, we calculate the absolute distances between the king's row/column
- * at the source position and the kins's row/column at the destination position.
+ * The function checks if the king of the current player is not threatened after the given piece
+ * movement is executed. The game itself is not changed: we calculate the occupancy of the board as if the piece
+ * moved, and a rival piece that would be "eaten" at the destination square is not considered as threatening.
  *
- * @param move - The move to be set with the knight
+ * @param game      - A Chess game
+ * @param srcSquare - The square of the piece that moves
+ * @param dstSquare - The square the piece moves to (one of the squares returned by getPieceMovesBitboard)
  *
  * @return
- * 		True  - If the movement by the king is legal (movement the creates "L" shape).
+ * 		True  - If the king of the current player is not threatened after the movement.
  * 		False - Otherwise.
  */
-bool legalMovementByKing(Move* move) {
-	int rowDifference = abs(move->dstRow - move->srcRow);
-	int colDifference = abs(move->dstCol - move->srcCol);
+bool kingSafeAfterMovement(SPChessGame* game, int srcSquare, int dstSquare) {
+	int currPlayer = game->currentPlayer;
+	int kingRow    = (currPlayer == WHITE_PLAYER) ? game->whiteKingRow : game->blackKingRow;
+	int kingCol    = (currPlayer == WHITE_PLAYER) ? game->whiteKingCol : game->blackKingCol;
+	int kingSquare = POSITION_TO_SQUARE(kingRow, kingCol);
+
+	Bitboard dstPosition = SQUARE_BITBOARD(dstSquare);
+	Bitboard occupancy   = ((game->allPieces & ~SQUARE_BITBOARD(srcSquare)) | dstPosition);
+	Bitboard captured    = (game->occupancy[!currPlayer] & dstPosition);
+
+	if (srcSquare == kingSquare)
+		kingSquare = dstSquare; // the king itself is the piece that moves
+
+	return !squareThreatenedByPlayer(game, kingSquare, !currPlayer, occupancy, captured);
+}
+
+/**
+ * The function updates the indicator of the given legal regular move that is needed for setting it: if the move is a pawn promotion.
+ *
+ * @param game - A Chess game
+ * @param move - A legal regular move of the current player
+ */
+void updateMoveIndicators(SPChessGame* game, Move* move) {
+	int  currPlayer = game->currentPlayer;
+	char srcPiece   = move->srcPiece;
+
+	if (   ((currPlayer == WHITE_PLAYER) && (srcPiece == WHITE_PAWN) && (move->dstRow == BLACK_FIRST_ROW))
+		|| ((currPlayer == BLACK_PLAYER) && (srcPiece == BLACK_PAWN) && (move->dstRow == WHITE_FIRST_ROW))) {
+
+				move->pawnPromotion = true; // helps us informing the user a "pawn promotion" occured
+	}
+}
+
+/**
+ * The function updates the indicator of the given legal regular move that is used only to inform the user (by the get_moves
+ * command and by the colored frames of the possible moves in the GUI), if the moving piece is not the king: if the piece is
+ * threatened after the move is executed. Calculating it takes a full scan of the rival's threats, so the moves that are
+ * generated for the Minimax algorithm don't get it.
+ *
+ * @param game - A Chess game
+ * @param move - A legal regular move of the current player
+ */
+void updateMoveAnnotations(SPChessGame* game, Move* move) {
+	int  currPlayer = game->currentPlayer;
+	char srcPiece   = move->srcPiece;
+
+	if ((srcPiece == WHITE_KING) || (srcPiece == BLACK_KING))
+		return;
 
-	return ((rowDifference <= 1) && (colDifference <= 1));
+	int      dstSquare   = POSITION_TO_SQUARE(move->dstRow, move->dstCol);
+	Bitboard dstPosition = SQUARE_BITBOARD(dstSquare);
+	Bitboard occupancy   = ((game->allPieces & ~SQUARE_BITBOARD(POSITION_TO_SQUARE(move->srcRow, move->srcCol))) | dstPosition);
+	Bitboard captured    = (game->occupancy[!currPlayer] & dstPosition);
+
+	// updating this indicator for the use of get_moves command by the user
+	move->threatenedAfterMove = squareThreatenedByPlayer(game, dstSquare, !currPlayer, occupancy, captured);
 }
 
 /**
@@ -357,8 +531,8 @@ bool legalMovementByKing(Move* move) {
  * @param move - The move to be set in the game
  */
 void setRegularMove(SPChessGame* game, Move* move) {
-	game->board[move->srcRow][move->srcCol] = EMPTY_POSITION; // the position of the "source piece" gets empty
-	game->board[move->dstRow][move->dstCol] = move->srcPiece; // the destination position gets filles by the "source piece"
+	removePiece(game, move->srcRow, move->srcCol);                   // the position of the "source piece" gets empty
+	placePiece(game, move->dstRow, move->dstCol, move->srcPiece);    // the destination position gets filles by the "source piece"
 
 	char srcPiece = move->srcPiece;
 
@@ -420,18 +594,15 @@ bool legalCastle(SPChessGame* game, Move* move) {
 	int srcCol = move->srcCol;
 	char rookType = move->srcPiece;
 	int  rowToCheck;
-	char kingType;
 	bool leftCastle, rightCastle;
 
 	if (rookType == WHITE_ROOK) {
 		rowToCheck      = WHITE_FIRST_ROW;
-		kingType        = WHITE_KING;
 		leftCastle      = game->whiteLeftCastle;
 		rightCastle     = game->whiteRightCastle;
 	}
 	else {
 		rowToCheck      = BLACK_FIRST_ROW;
-		kingType        = BLACK_KING;
 		leftCastle      = game->blackLeftCastle;
 		rightCastle     = game->blackRightCastle;
 	}
@@ -443,7 +614,7 @@ bool legalCastle(SPChessGame* game, Move* move) {
 				return false;
 	}
 
-	return legalCastleRoute(game, rookType, srcCol, kingType);
+	return legalCastleRoute(game, rookType, srcCol);
 }
 
 /**
@@ -454,14 +625,14 @@ bool legalCastle(SPChessGame* game, Move* move) {
  * Then, we go through every position on the route between the king and the relevant rook (not including their positions - the fact that the king
  * is not threatened at its place at the moment is a precondition of this function).
  * For each such position, we verify that it is empty and that in each one of them - the king is not threatened (i.e. the player
- * would not have been under check if the king was placed at that position).
+ * would not have been under check if the king was placed at that position). The king is "placed" at the position by
+ * sending the helper function squareThreatenedByPlayer the board occupancy with the king moved there, so the board is not changed.
  * The route is considered legal (and hence the castle move) if all the positions on
  * the relevant route fulfilled the conditions that were mentioned above.
  *
  * @param game     - A Chess game
  * @param rookType - The rook that belongs to the player, that is trying to make a castle with its king
  * @param rookCol  - The column of the rook that is represented in the rookType parameter
- * @param kingType - The king that belongs to the current player that plays the castle move
  *
  * @precondition - The player to make the move is not under "check" (i.e. its king is not threatened at the current game board)
  *
@@ -469,10 +640,12 @@ bool legalCastle(SPChessGame* game, Move* move) {
  * 		True  - If the route between the rook and the king is a legal castle route.
  * 		False - Otherwise.
  */
-bool legalCastleRoute(SPChessGame* game, int rookType, int rookCol, char kingType) {
+bool legalCastleRoute(SPChessGame* game, int rookType, int rookCol) {
 	int rowOfCastle = (rookType == WHITE_ROOK) ? WHITE_FIRST_ROW    : BLACK_FIRST_ROW;
 	int kingCol     = (rookType == WHITE_ROOK) ? game->whiteKingCol : game->blackKingCol;
+	int rival       = !(game->currentPlayer);
 
+	Bitboard occupancyWithoutKing = (game->allPieces & ~SQUARE_BITBOARD(POSITION_TO_SQUARE(rowOfCastle, kingCol)));
 
 	int  startOfKingCheckPath, endOfKingCheckPath;
 	bool isLegal = false;
@@ -488,18 +661,14 @@ bool legalCastleRoute(SPChessGame* game, int rookType, int rookCol, char kingTyp
 
 	// check if the path between the rook and the king is vacant, and the king is not threatened in each of the route's positions
 	for (int colOfPath = startOfKingCheckPath; colOfPath <= endOfKingCheckPath; colOfPath++) {
-		if (game->board[rowOfCastle][colOfPath] != EMPTY_POSITION)
-			return false;
+		int      pathSquare   = POSITION_TO_SQUARE(rowOfCastle, colOfPath);
+		Bitboard pathPosition = SQUARE_BITBOARD(pathSquare);
 
-		// update the board to see if the king is threatened at the next position of the castle route
-		game->board[rowOfCastle][kingCol]   = EMPTY_POSITION;
-		game->board[rowOfCastle][colOfPath] = kingType;
-
-		isLegal = !rivalPlayerThreateningPosition(game, rowOfCastle, colOfPath); // valid if king does not pass through or lands into check
+		if (game->allPieces & pathPosition)
+			return false;
 
-		// restore game board
-		game->board[rowOfCastle][kingCol]   = kingType;
-		game->board[rowOfCastle][colOfPath] = EMPTY_POSITION;
+		// valid if king does not pass through or lands into check
+		isLegal = !squareThreatenedByPlayer(game, pathSquare, rival, (occupancyWithoutKing | pathPosition), EMPTY_BITBOARD);
 
 		if (!isLegal)
 			return false;
@@ -533,10 +702,10 @@ void setCastleMove(SPChessGame* game, Move* move) {
 	}
 
 	// update the game board according to the castle move
-	game->board[castleRow][dstKingCol]   = kingType ;
-	game->board[castleRow][move->srcCol] = EMPTY_POSITION;
-	game->board[castleRow][dstRookCol]   = rookType;
-	game->board[castleRow][KING_COL]     = EMPTY_POSITION;
+	removePiece(game, castleRow, KING_COL);
+	removePiece(game, castleRow, move->srcCol);
+	placePiece(game, castleRow, dstKingCol, kingType);
+	placePiece(game, castleRow, dstRookCol, rookType);
 
 	move->dstCol = dstRookCol;
 
@@ -551,15 +720,40 @@ void setCastleMove(SPChessGame* game, Move* move) {
 	}
 }
 
+/**
+ * The function sets the piece that a pawn is promoted to at the destination position of a pawn promotion move,
+ * and updates the relevant player's army. The next player to play and the game status are not updated.
+ *
+ * @param game       - A Chess game
+ * @param move       - The pawn promotion move (its source piece is the piece that the pawn is promoted to)
+ * @param removePawn - Indicates if the pawn should be removed from the source position (it was not removed yet
+ *                      only if the move didn't go through the "regular move route", i.e. a computer move)
+ */
+void setPawnPromotionMove(SPChessGame* game, Move* move, bool removePawn) {
+	char pawnType = (game->currentPlayer == WHITE_PLAYER) ? WHITE_PAWN : BLACK_PAWN;
+
+	if (removePawn)
+		removePiece(game, move->srcRow, move->srcCol);
+
+	// update the game board with the piece that the pawn was promoted to
+	placePiece(game, move->dstRow, move->dstCol, move->srcPiece);
+
+	// increasing the number of the piece replacing the pawn in the player's army (sending true means increasing)
+	updatePiecesAmount(game, move->srcPiece, true);
+
+	// decreasing the number of pawns in the player's army (sending false means decreasing)
+	updatePiecesAmount(game, pawnType, false);
+}
+
 /**
  * The function makes the relevant updates that should be made after a setting a move (every king of move).
  * If the move is not a pawn promotion move, the function calls at its end to the helper function changePlayerAndUpdateStatus,
  * that can fail if a memory error occurs (that's why the function returns an SP_CHESS_GAME_MESSAGE.
  * The upadtes of the next player to play and the game status happen after a pawn promotion move happen in its own set function.
+ * During the Minimax algorithm (every kind of move) only the next player to play is updated, by calling the helper function changePlayer.
  *
  * @param game        - A Chess game
  * @param move        - The move that was set
- * @param history     - The array list the includes the history of the game moves
  * @param minimaxMove - Indicates of the move was set during the Minimaax algorithm
  *
  * @return
@@ -568,7 +762,7 @@ void setCastleMove(SPChessGame* game, Move* move) {
  *
  * 		SP_CHESS_GAME_SUCCESS - Otherwise.
  */
-SP_CHESS_GAME_MESSAGE updatesAfterSettingMove(SPChessGame* game, Move* move, SPArrayList* history, bool minimaxMove) {
+SP_CHESS_GAME_MESSAGE updatesAfterSettingMove(SPChessGame* game, Move* move, bool minimaxMove) {
 	// updates if a piece was "eaten" at the destination position
 	if (move->dstPieceCaptured) {
 		updatePiecesAmount(game, move->dstPiece, false);
@@ -581,15 +775,17 @@ SP_CHESS_GAME_MESSAGE updatesAfterSettingMove(SPChessGame* game, Move* move, SPA
 			updateCastlingIndicators(move, dstPiece, &(game->blackLeftCastle), &(game->blackRightCastle));
 	}
 
+	// replacing the key of the castling indicators before the move (saved in the move) with the key of the current ones
+	game->zobristKey ^= spZobristCastlingKey(move->whiteLeftCastle, move->whiteRightCastle, move->blackLeftCastle, move->blackRightCastle)
+					  ^ gameCastlingKey(game);
+
 	/**
-	 * saving move to history (during the Minimax algorithm we don't save the
-	 * moves in the history, because an undo is not executed during there
+	 * during the Minimax algorithm the game status is not calculated after the move (the search detects a finished game
+	 * by itself, when it generates the moves of the next position and finds none)
 	 */
-	if (!minimaxMove) {
-		if (spArrayListIsFull(history))
-			spArrayListRemoveFirst(history);
-
-		spArrayListAddLast(history, move);
+	if (minimaxMove) {
+		changePlayer(game);
+		return SP_CHESS_GAME_SUCCESS;
 	}
 
 	if (!move->pawnPromotion)
@@ -720,10 +916,10 @@ void undoCastleMove(SPChessGame* game, Move* move) {
 	}
 
 	// recover the game board to the state before the castle move
-	game->board[castleRow][KING_COL]    = kingType;
-	game->board[castleRow][currKingCol] = EMPTY_POSITION;
-	game->board[castleRow][srcRookCol]  = rookType;
-	game->board[castleRow][currRookCol] = EMPTY_POSITION;
+	removePiece(game, castleRow, currKingCol);
+	removePiece(game, castleRow, currRookCol);
+	placePiece(game, castleRow, KING_COL, kingType);
+	placePiece(game, castleRow, srcRookCol, rookType);
 
 	// update the relevant king position
 	if (kingType == WHITE_KING)
@@ -733,7 +929,75 @@ void undoCastleMove(SPChessGame* game, Move* move) {
 }
 
 /**
- * The function update the next player to play a move.
+ * The function reverts the given move, that was the last move to be set in the game.
+ * In case of a castle move, we update the board when calling the helper function undoCastleMove.
+ * Otherwise, we update the board in this function.
+ * In addition, we recover the castling indicators, the king position (if relevant, i.e. if a king was involved in the move),
+ * the relevant player's army, the current player and the game Zobrist key. The game status and the game history are not updated.
+ *
+ * @param game - A Chess game
+ * @param move - The last move that was set and should be reverted
+ */
+void undoSettingMove(SPChessGame* game, Move* move) {
+	char movingPlayer = !(game->currentPlayer); // the player that made the move
+	char pawnType     = (movingPlayer == WHITE_PLAYER) ? WHITE_PAWN : BLACK_PAWN;
+
+	// updating the game board
+	if (move->castleMove)
+		undoCastleMove(game, move);
+	else {
+		char originalSrcPiece = (move->pawnPromotion) ? pawnType : move->srcPiece;
+
+		placePiece(game, move->srcRow, move->srcCol, originalSrcPiece);
+		placePiece(game, move->dstRow, move->dstCol, move->dstPiece); // empties the position if no piece was "eaten"
+	}
+
+	// recovering the castling indicatiors that were saved when the move was set (and their Zobrist key)
+	game->zobristKey      ^= gameCastlingKey(game);
+	game->whiteLeftCastle  = move->whiteLeftCastle;
+	game->whiteRightCastle = move->whiteRightCastle;
+	game->blackLeftCastle  = move->blackLeftCastle;
+	game->blackRightCastle = move->blackRightCastle;
+	game->zobristKey      ^= gameCastlingKey(game);
+
+	// recover the relevant king's position if it was moved
+	if (move->srcPiece == WHITE_KING) {
+		game->whiteKingRow = move->srcRow;
+		game->whiteKingCol = move->srcCol;
+	}
+	else if (move->srcPiece == BLACK_KING) {
+		game->blackKingRow = move->srcRow;
+		game->blackKingCol = move->srcCol;
+	}
+
+	// if not a castle and a piece was eaten - recounting the number of pieces for the "eaten" player
+	if (!(move->castleMove)) {
+		if (move->dstPieceCaptured)
+			updatePiecesAmount(game, move->dstPiece, true);
+
+		// the pawn that was promoted belongs to the player that made the move
+		if (move->pawnPromotion) {
+			updatePiecesAmount(game, move->srcPiece, false);
+			updatePiecesAmount(game, pawnType, true);
+		}
+	}
+
+	game->currentPlayer = movingPlayer; // updating the cuurent player to be the player that made the move
+	game->zobristKey   ^= spZobristSideKey();
+}
+
+/**
+ * The function updates the next player to play a move (and the game Zobrist key). The game status is not updated.
+ *
+ * @param game - A Chess game
+ */
+void changePlayer(SPChessGame* game) {
+	game->currentPlayer = !(game->currentPlayer); // because white/black players are represented with 1/0
+	game->zobristKey   ^= spZobristSideKey();
+}
+
+/**
+ * The function update the next player to play a move (by calling the helper function changePlayer).
  * In addition, the function updates the current game status, doing so by calling the helper function getGameStatus.
  *
  * @param game - A Chess game
@@ -744,7 +1008,7 @@ void undoCastleMove(SPChessGame* game, Move* move) {
  * 		SP_CHESS_GAME_SUCCESS   - Otherwise.
  */
 SP_CHESS_GAME_MESSAGE changePlayerAndUpdateStatus(SPChessGame* game) {
-	game->currentPlayer = !(game->currentPlayer); // because white/black players are represented with 1/0
+	changePlayer(game);
 
 	game->status = (game->currentPlayer == WHITE_PLAYER) ? getGameStatus(game, game->whiteKingRow, game->whiteKingCol)
 														 : getGameStatus(game, game->blackKingRow, game->blackKingCol);
@@ -759,7 +1023,8 @@ SP_CHESS_GAME_MESSAGE changePlayerAndUpdateStatus(SPChessGame* game) {
  * The function checks what is the current game status and returns it.
  * The technique to do so is to:
  * First, call a helper function that returns if the next player to play is under "check" at the current game state.
- * Second, by callig the helper function getPossiblePieceMoves, we see if the the next player to play has at least 1 possible move to make.
+ * Second, after calculating the legality masks of the position (by calling the helper function getLegalityMasks),
+ * by callig the helper function playerHasPossibleMove, we see if the the next player to play has at least 1 possible move to make.
  * If the next player to play has no possible moves either he has lost (under "checkmate") or the game is tied ("stalemate").
  * Otherwise, either he is under "check" or there is no "check".
  *
@@ -768,8 +1033,6 @@ SP_CHESS_GAME_MESSAGE changePlayerAndUpdateStatus(SPChessGame* game) {
  * @param kingCol - The column of the king that belongs to the next player to play
  *
  * @return
- * 		MEMORY_FAILURE             - If there eas a memory error during the run of the function
- * 		                              itself or during the run of its helper function.
  * 		WHITE_PLAYER_WINS          - If the white player is the winner of the game.
  * 		BLACK_PLAYER_WINS          - If the black player is the winner of the game.
  * 		GAME_NOT_FINISHED_CHECK    - If the next player to play is under "check" (i.e. his king is currently threatened)
@@ -780,654 +1043,287 @@ SP_CHESS_GAME_MESSAGE changePlayerAndUpdateStatus(SPChessGame* game) {
  * 								      but he cannot produce anymore legal moves.
  */
 GAME_STATUS getGameStatus(SPChessGame* game, int kingRow, int kingCol) {
-	bool thereIsPossibleMove = false;
 	bool isCheck = rivalPlayerThreateningPosition(game, kingRow, kingCol);
 
-	SPArrayList* pieceMoves = spArrayListCreate(MAX_MOVES_FOR_PIECE); // the highest number of moves
-	if (pieceMoves == NULL)
-		return MEMORY_FAILURE;
-
-	// we stop the iteration if the next player to play has at least one possible move to make
-	for (int row = 0; (!thereIsPossibleMove && (row < BOARD_LENGTH)); row++) {
-		for (int col = 0; (!thereIsPossibleMove && (col < BOARD_LENGTH)); col++) {
-			char pieceType = game->board[row][col];
-			if (!currentPlayerPiece(game->currentPlayer, pieceType))
-					continue;
-
-			if (getPossiblePieceMoves(game, pieceMoves, row, col, pieceType, false, false) == SP_CHESS_GAME_MEMORY_FAILURE) {
-				spArrayListDestroy(pieceMoves);
-				return MEMORY_FAILURE;
-			}
-
-			thereIsPossibleMove = !spArrayListIsEmpty(pieceMoves);
-		}
-
-		spArrayListClear(pieceMoves);
-	}
-
-	spArrayListDestroy(pieceMoves); // free the memory of the array list we allocated for the possible moves
+	LegalityMasks masks;
+	getLegalityMasks(game, &masks);
 
-	if (thereIsPossibleMove) {
+	if (playerHasPossibleMove(game, &masks)) {
 		if (isCheck)
 			return GAME_NOT_FINISHED_CHECK;          // "check" situation
 		else
 			return GAME_NOT_FINISHED_NO_CHECK;       // still to play
 	}
-	else {
-		if (isCheck) {
-			if (game->currentPlayer == WHITE_PLAYER)
-				return BLACK_PLAYER_WINS;            // "checkmate" - black player wins
-			else
-				return WHITE_PLAYER_WINS;            // "checkmate" - white player wins
-		}
-		else
-			return TIED_GAME;                        // tie
-	}
-}
-
-/**
- * The function checks if given position (occupied by a piece of the currently playing player) is currently threatened by the rival player.
- * The function uses the helper function rivalPieceThreateningPosition, by calling it each time with another type of piece that
- * belongs to the rival - these way we check all the posssibilities to threaten the position.
- *
- * @param game        - A Chess game
- * @param positionRow - The row of the position that we need to check if threatend by the rival player
- * @param positionCol - The column of the position that we need to check if threatend by the rival player
- *
- * @return
- * 		TRUE  - If the position is threatend by at least one piece that belongs to the rival.
- * 		FALSE - Otherwise.
- */
-bool rivalPlayerThreateningPosition(SPChessGame* game, int positionRow, int positionCol) {
-	char pawnToCheck, knightToCheck, bishopToCheck, rookToCheck, queenToCheck, kingToCheck;
-	int currPlayer = game->currentPlayer;
-
-	if (currPlayer == WHITE_PLAYER) {
-		pawnToCheck   = BLACK_PAWN;
-		knightToCheck = BLACK_KNIGHT;
-		bishopToCheck = BLACK_BISHOP;
-		rookToCheck   = BLACK_ROOK;
-		queenToCheck  = BLACK_QUEEN;
-		kingToCheck   = BLACK_KING;
-	}
-	else {
-		pawnToCheck   = WHITE_PAWN;
-		knightToCheck = WHITE_KNIGHT;
-		bishopToCheck = WHITE_BISHOP;
-		rookToCheck   = WHITE_ROOK;
-		queenToCheck  = WHITE_QUEEN;
-		kingToCheck   = WHITE_KING;
-	}
-
-	// check if king is under threat
-	return (   rivalPieceThreateningPosition(game->board, positionRow, positionCol, pawnToCheck)
-			|| rivalPieceThreateningPosition(game->board, positionRow, positionCol, knightToCheck)
-			|| rivalPieceThreateningPosition(game->board, positionRow, positionCol, bishopToCheck)
-			|| rivalPieceThreateningPosition(game->board, positionRow, positionCol, rookToCheck)
-			|| rivalPieceThreateningPosition(game->board, positionRow, positionCol, queenToCheck)
-			|| rivalPieceThreateningPosition(game->board, positionRow, positionCol, kingToCheck));
+	else
+		return finishedGameStatus(game, isCheck);
 }
 
 /**
- * The function checks if the given piece threatens the given position.
- * By using a "switch case", we make a special check for every king of piece, according to its legal movement on a Chess board.
- * Note that because the queen can move like the bishop and also like the rook, we check if it threatens the position by moving
- * like a bishop or by moving like a rook.
+ * The function returns the status of a game where the next player to play has no legal moves to make:
+ * either he has lost (under "checkmate") or the game is tied ("stalemate").
  *
- * @param board     - A Chess game board
- * @param srcRow    - The row of the position that we need to check if threatend
- * @param srcCol    - The column of the position that we need to check if threatend
- * @param pieceType - The type of piece that we need to check if threatens the given position
+ * @param game    - A Chess game
+ * @param isCheck - Indicates if the next player to play is under "check"
  *
  * @return
- * 		TRUE  - If the given position is indeed threatend by the given piece (using the helper function pieceOccupyingPosition).
- * 		FALSE - Otherwise.
+ * 		WHITE_PLAYER_WINS - If the black player is under "checkmate".
+ * 		BLACK_PLAYER_WINS - If the white player is under "checkmate".
+ * 		TIED_GAME         - If the next player to play is not under "check".
  */
-bool rivalPieceThreateningPosition(char board[][BOARD_LENGTH], int srcRow, int srcCol, char pieceType) {
-	switch (pieceType) {
-		case WHITE_PAWN:
-			// a white pawn might threaten the position from one row downwards (and by "eating" diagonally)
-			return (   pieceOccupyingPosition(board, srcRow - 1, srcCol - 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow - 1, srcCol + 1, pieceType));
-		case BLACK_PAWN:
-			// a black pawn might threaten the position from one row upwards (and by "eating" diagonally)
-			return (   pieceOccupyingPosition(board, srcRow + 1, srcCol - 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 1, srcCol + 1, pieceType));
-		case WHITE_KNIGHT:
-		case BLACK_KNIGHT:
-			// both a white and a black knights might threaten the position from the same 8 different position (moving in the shape of an "L")
-			return (   pieceOccupyingPosition(board, srcRow - 2, srcCol - 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow - 2, srcCol + 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow - 1, srcCol - 2, pieceType)
-					|| pieceOccupyingPosition(board, srcRow - 1, srcCol + 2, pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 1, srcCol - 2, pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 1, srcCol + 2, pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 2, srcCol - 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 2, srcCol + 1, pieceType));
-		case WHITE_BISHOP:
-		case BLACK_BISHOP:
-			return  bishopOrQueenThreat(board, srcRow, srcCol, pieceType);
-		case WHITE_ROOK:
-		case BLACK_ROOK:
-			return  rookOrQueenThreat(board, srcRow, srcCol, pieceType);
-		case WHITE_QUEEN:
-		case BLACK_QUEEN:
-			return (   bishopOrQueenThreat(board, srcRow, srcCol, pieceType)
-					|| rookOrQueenThreat(board, srcRow, srcCol, pieceType));
-		case WHITE_KING:
-		case BLACK_KING:
-			/* both a white and a black king might threaten the position from the same 8 different position (by moving to
-			   a square on the that surrounds the given position */
-			return (   pieceOccupyingPosition(board, srcRow - 1, srcCol - 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow - 1, srcCol    , pieceType)
-					|| pieceOccupyingPosition(board, srcRow - 1, srcCol + 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow    , srcCol - 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow    , srcCol + 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 1, srcCol - 1, pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 1, srcCol    , pieceType)
-					|| pieceOccupyingPosition(board, srcRow + 1, srcCol + 1, pieceType));
+GAME_STATUS finishedGameStatus(SPChessGame* game, bool isCheck) {
+	if (isCheck) {
+		if (game->currentPlayer == WHITE_PLAYER)
+			return BLACK_PLAYER_WINS;                // "checkmate" - black player wins
+		else
+			return WHITE_PLAYER_WINS;                // "checkmate" - white player wins
 	}
 
-	return false;
-}
-
-/**
- * The function checks if the given bishop/queen threatens the given position.
- * We take advantage of the fact that the queen can move also like the rook.
- * The function is doing the checking by calling the helper function directionalThreat each time
- * with a different direction (we go from the given position to the possibly threatening piece):
- * 1) By moving diagonally downwards to the left
- * 2) By moving diagonally downwards to the right
- * 3) By moving diagonally upwards to the left
- * 4) By moving diagonally upwards to the right
- *
- * @param board     - A Chess game board
- * @param srcRow    - The row of the position that we need to check if threatend
- * @param srcCol    - The column of the position that we need to check if threatend
- * @param pieceType - The type of piece that we need to check if threatens the given position
- *
- * @return
- * 		TRUE  - If the position is threatend by the given bishop/queen in at least one of the possible directions.
- * 		FALSE - Otherwise.
- */
-bool bishopOrQueenThreat(char board[][BOARD_LENGTH], int srcRow, int srcCol, char pieceType) {
-	return (   directionalThreat(board, srcRow, srcCol, GOING_DOWNWARDS, GOING_LEFT , pieceType)
-			|| directionalThreat(board, srcRow, srcCol, GOING_DOWNWARDS, GOING_RIGHT, pieceType)
-			|| directionalThreat(board, srcRow, srcCol, GOING_UPWARDS  , GOING_LEFT , pieceType)
-			|| directionalThreat(board, srcRow, srcCol, GOING_UPWARDS  , GOING_RIGHT, pieceType));
+	return TIED_GAME;                                // tie
 }
 
 /**
- * The function checks if the given rook/queen threatens the given position.
- * We take advantage of the fact that the queen can move also like the rook.
- * The function is doing the checking by calling the helper function directionalThreat each time with a different
- * direction (we go from the given position to the possibly threatening piece):
- * 1) By moving vertically downwards
- * 2) By moving horizontally to the left
- * 3) By moving horizontally to the right
- * 4) By moving vertically upwards
- *
- * @param board     - A Chess game board
- * @param srcRow    - The row of the position that we need to check if threatend
- * @param srcCol    - The column of the position that we need to check if threatend
- * @param pieceType - The type of piece that we need to check if threatens the given position
+ * The function returns the status of a game where the next player to play still has legal moves to make,
+ * according to the legality masks of the current position (the player is under "check" if not every position blocks a check).
  *
- * @return
- * 		TRUE  - If the position is threatend by the given rook/queen in at least one of the possible directions.
- * 		FALSE - Otherwise.
- */
-bool rookOrQueenThreat(char board[][BOARD_LENGTH], int srcRow, int srcCol, char pieceType) {
-	return (   directionalThreat(board, srcRow, srcCol, GOING_DOWNWARDS, SAME_COL    , pieceType)
-			|| directionalThreat(board, srcRow, srcCol, SAME_ROW       , GOING_LEFT  , pieceType)
-			|| directionalThreat(board, srcRow, srcCol, SAME_ROW       , GOING_RIGHT , pieceType)
-			|| directionalThreat(board, srcRow, srcCol, GOING_UPWARDS  , SAME_COL    , pieceType));
-}
-
-/**
- * The function checks if the given type of piece threatens the given position in the given direction.
- * We do this checking by starting from the given position and going sqaure-by-square on the given board
- * according to the given direction: We stop when we either reached an invalid position or when we encountered
- * a piece (and in this case we check if it from the type of piece we received as a parameter.
- *
- * @param board     - A Chess game board
- * @param srcRow    - The row of the position that we need to check if threatend
- * @param srcCol    - The column of the position that we need to check if threatend
- * @param deltaRow  - The movement in terms of row that should be made when going to the next position sqare-by-square:
- * 					   Either one row up, one row down or staying at the same row
- * @param deltaCol  - The movement in terms of column that should be made when going to the next position sqare-by-square:
- * 					   Either one column up, one column down or staying at the same column
- * @param pieceType - The type of piece that we check if threatens the given position
+ * @param masks - The legality masks of the current position (filled by getLegalityMasks)
  *
  * @return
- * 		TRUE  - If the track from the given positino was stopped on a valid position that is occupied by the given type of piece.
- * 		FALSE - Otherwise.
+ * 		GAME_NOT_FINISHED_CHECK    - If the next player to play is under "check".
+ * 		GAME_NOT_FINISHED_NO_CHECK - Otherwise.
  */
-bool directionalThreat(char board[][BOARD_LENGTH], int srcRow, int srcCol, int deltaRow, int deltaCol, char pieceType) {
-	int currRowToCheck = srcRow;
-	int currColToCheck = srcCol;
-	bool validPos;
-
-	// We advance along the direction, advancing by deltaRow,deltaCol - in each iteration.
-	// We will stop once we no longer hit an empty square or when we reached an invalid position.
-	do {
-		currRowToCheck += deltaRow;
-		currColToCheck += deltaCol;
-		validPos = validPosition(currRowToCheck, currColToCheck);
-	} while (validPos && (board[currRowToCheck][currColToCheck] == EMPTY_POSITION));
-
-	return (validPos && pieceOccupyingPosition(board, currRowToCheck, currColToCheck, pieceType));
+GAME_STATUS unfinishedGameStatus(const LegalityMasks* masks) {
+	return ((masks->checkMask != FULL_BITBOARD) ? GAME_NOT_FINISHED_CHECK : GAME_NOT_FINISHED_NO_CHECK);
 }
 
 /**
- * The function calculates all the possible moves from the a given position on the board by the given piece.
- * For each kind of piece, the function calls to a different helper function.
+ * The function checks if the player which is its turn to play has at least one legal move to make.
+ * For every piece of the player we calculate the positions it can legally move to (by calling the helper function
+ * getLegalPieceMovesBitboard), and stop as soon as one of the pieces has at least one. No moves are allocated during the check.
+ * The pieces are taken type by type from the bitboards of the player (the piece list of every type), so only the live pieces are
+ * visited and neither the board nor the type of a piece is read.
+ * Castle moves are not checked: a legal castle means that the king can also legally move one square towards the rook.
  *
- * @param game      - A Chess game
- * @param moves     - The array list where the possible moves will be added to
- * @param srcRow    - The row of the given piece's position
- * @param srcCol    - The column of the given piece's position
- * @param pieceType - The type of the given piece
- * @param sort      - Indicates if the possible moves hould be sorted
- * @param minimax   - Indicates if the moves are for the Minimax algorithm
+ * @param game  - A Chess game
+ * @param masks - The legality masks of the current position (filled by getLegalityMasks)
  *
  * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE   - If a memory failure occurred in the helper function that was called.
- *		SP_CHESS_GAME_INVALID_ARGUMENT - returned as a default (shouldn't get to that point in the function).
- *		Otherwise - returns the SP_CHESS_GAME_MESSAGE that got back from the relevant helper function.
+ * 		True  - If the current player has at least one legal move.
+ * 		False - Otherwise.
  */
-SP_CHESS_GAME_MESSAGE getPossiblePieceMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, char pieceType, bool sort, bool minimax) {
-	switch (pieceType) {
-		case WHITE_PAWN:
-		case BLACK_PAWN:
-			return getPossiblePawnMoves(game, moves, srcRow, srcCol, minimax);
-
-		case WHITE_KNIGHT:
-		case BLACK_KNIGHT:
-			return getPossibleKnightMoves(game, moves, srcRow, srcCol);
-
-		case WHITE_BISHOP:
-		case BLACK_BISHOP:
-			return getPossibleBishopOrQueenMoves(game, moves, srcRow, srcCol, sort);
-
-		case WHITE_ROOK:
-		case BLACK_ROOK:
-			return getPossibleRookOrQueenMoves(game, moves, srcRow, srcCol, sort);
-
-		case WHITE_QUEEN:
-		case BLACK_QUEEN:
-			// first we get the moves when moving like a bishop
-			if (getPossibleBishopOrQueenMoves(game, moves, srcRow, srcCol, sort) == SP_CHESS_GAME_MEMORY_FAILURE)
-				return SP_CHESS_GAME_MEMORY_FAILURE;
+bool playerHasPossibleMove(SPChessGame* game, const LegalityMasks* masks) {
+	int currPlayer = game->currentPlayer;
 
-			// than we get the moves when moving like a rook
-			return getPossibleRookOrQueenMoves(game, moves, srcRow, srcCol, sort);
+	for (int type = 0; type < NUM_OF_PIECE_TYPES; type++) {
+		Bitboard pieces = game->pieces[currPlayer][type];
+		char     piece  = getPlayerPiece(currPlayer, type);
 
-		case WHITE_KING:
-		case BLACK_KING:
-			return getPossibleKingMoves(game, moves, srcRow, srcCol);
+		while (pieces != EMPTY_BITBOARD) {
+			int srcSquare = spBitboardPopFirstSquare(&pieces);
 
-		default:
-			return SP_CHESS_GAME_INVALID_ARGUMENT; // just to prevent logical error had to return something, shouldn't get here
+			if (getLegalPieceMovesBitboard(game, SQUARE_ROW(srcSquare), SQUARE_COL(srcSquare), piece, masks) != EMPTY_BITBOARD)
+				return true;
+		}
 	}
+
+	return false;
 }
 
 /**
- * The function calculates all the possible moves for the pawn that is in the given position.
- * Every move is added to the array list by calling the helper function addPieceMove.
- * The moves are added in a sorted way (rows from low to high as the main order, and columns from low to high as a secondary order).
+ * The function checks if given position (occupied by a piece of the currently playing player) is currently threatened by the rival player,
+ * by calling the helper function squareThreatenedByPlayer with the current occupancy of the board.
  *
- * @param game    - A Chess game
- * @param moves   - The array list where the possible moves will be added to
- * @param srcRow  - The row of the given pawn's position
- * @param srcCol  - The column of the given pawn's position
- * @param minimax - Indicates if the moves are for the Minimax algorithm
+ * @param game        - A Chess game
+ * @param positionRow - The row of the position that we need to check if threatend by the rival player
+ * @param positionCol - The column of the position that we need to check if threatend by the rival player
  *
  * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise.
+ * 		TRUE  - If the position is threatend by at least one piece that belongs to the rival.
+ * 		FALSE - Otherwise.
  */
-SP_CHESS_GAME_MESSAGE getPossiblePawnMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, bool minimax) {
-	int dstRow;
-
-	// moving a pawn 2 rows downwards for the black player
-	if (   (game->currentPlayer == BLACK_PLAYER)
-		&& (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 2),  srcCol, false, false) == SP_CHESS_GAME_MEMORY_FAILURE)) {
-
-				return SP_CHESS_GAME_MEMORY_FAILURE;
-	}
-
-	// white pawn advances upwards, black pawn advances downwards
-	dstRow = (game->currentPlayer == WHITE_PLAYER) ? (srcRow + 1) : (srcRow - 1);
-
-	// eating to the left
-	if (addPieceMove(game, moves, srcRow, srcCol, dstRow, (srcCol - 1), false, minimax) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// going forwards/backwards 1 row
-	if (addPieceMove(game, moves, srcRow, srcCol, dstRow,  srcCol     , false, minimax) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// eating to the right
-	if (addPieceMove(game, moves, srcRow, srcCol, dstRow, (srcCol + 1), false, minimax) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// moving a pawn 2 rows upwards for the white player
-	if (   (game->currentPlayer == WHITE_PLAYER)
-		&& (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 2), srcCol, false, false) == SP_CHESS_GAME_MEMORY_FAILURE)) {
-
-				return SP_CHESS_GAME_MEMORY_FAILURE;
-	}
-
-	return SP_CHESS_GAME_SUCCESS;
+bool rivalPlayerThreateningPosition(SPChessGame* game, int positionRow, int positionCol) {
+	return squareThreatenedByPlayer(game, POSITION_TO_SQUARE(positionRow, positionCol), !(game->currentPlayer), game->allPieces, EMPTY_BITBOARD);
 }
 
 /**
- * The function calculates all the possible moves for the knight that is in the given position.
- * Every move is added to the array list by calling the helper function addPieceMove.
- * The moves are added in a sorted way (rows from low to high as the main order, and columns from low to high as a secondary order).
+ * The function checks if the given square is threatened by at least one of the pieces of the given player,
+ * by calling the helper function squareAttackers.
  *
- * @param game   - A Chess game
- * @param moves  - The array list where the possible moves will be added to
- * @param srcRow - The row of the given pawn's position
- * @param srcCol - The column of the given pawn's position
+ * @param game      - A Chess game
+ * @param square    - The square that we need to check if threatened
+ * @param player    - The player that its pieces might threaten the square
+ * @param occupancy - The occupied positions on the board (might differ from the game's occupancy when checking a move before it is set)
+ * @param captured  - The position of a piece of the given player that is considered as "eaten" (EMPTY_BITBOARD if there is none)
  *
  * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise.
+ * 		TRUE  - If the square is threatend by at least one piece of the given player.
+ * 		FALSE - Otherwise.
  */
-SP_CHESS_GAME_MESSAGE getPossibleKnightMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol) {
-
-	// All the 8 moves that might be possible by a knight sorted according to what is explained above
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 2), (srcCol - 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 2), (srcCol + 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 1), (srcCol - 2), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 1), (srcCol + 2), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 1), (srcCol - 2), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 1), (srcCol + 2), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 2), (srcCol - 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 2), (srcCol + 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	return SP_CHESS_GAME_SUCCESS;
+bool squareThreatenedByPlayer(SPChessGame* game, int square, int player, Bitboard occupancy, Bitboard captured) {
+	return ((squareAttackers(game, square, player, occupancy) & ~captured) != EMPTY_BITBOARD);
 }
 
 /**
- * The function calculates all the possible for the bishop/queen that is in the given position.
- * We take advantage of the fact that the queen can move also like the bishop.
- * The function calls a helper function (getDirectionalMoves) that adds all the possible moves by the relevant piece,
- * each time along a different direcional route:
- * 1) By moving diagonally downwards to the left
- * 2) By moving diagonally downwards to the right
- * 3) By moving diagonally upwards to the left
- * 4) By moving diagonally upwards to the right
- *
- * The moves are added then sorted if the function is ordered to do so (The sort order is: rows from low to high as the main order,
- * and columns from low to high as a secondary order).
+ * The function returns the pieces of the given player that threaten the given square.
+ * Instead of going from the square towards every possible threatening piece, we calculate the squares from which a piece
+ * of each type would threaten the square, and intersect them with the bitboard of the player's pieces of that type.
+ * This works because the movement of every piece is symmetric, except for the pawn: a pawn threatens the square
+ * if a pawn of the other color at the square would have threatened the pawn's position.
+ * Note that because the queen can move like the bishop and also like the rook, it is checked together with both of them.
  *
- * @param game   - A Chess game
- * @param moves  - The array list where the possible moves will be added to
- * @param srcRow - The row of the given pawn's position
- * @param srcCol - The column of the given pawn's position
- * @param sort   - Indicated if the moves that were calculated should get sorted
+ * @param game      - A Chess game
+ * @param square    - The square that we need to find its attackers
+ * @param player    - The player that its pieces might threaten the square
+ * @param occupancy - The occupied positions on the board (might differ from the game's occupancy when checking a move before it is set)
  *
  * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove
- *										or when calling the helper function sortMoves.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise.
+ * 		A bitboard of the positions of the player's pieces that threaten the square.
  */
-SP_CHESS_GAME_MESSAGE getPossibleBishopOrQueenMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, bool sort) {
-	// down and left
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, GOING_DOWNWARDS, GOING_LEFT)  == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// down and right
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, GOING_DOWNWARDS, GOING_RIGHT) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// up and left
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, GOING_UPWARDS  , GOING_LEFT)  == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// up and right
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, GOING_UPWARDS  , GOING_RIGHT) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-
-	if (sort) {
-		int movesAmount = spArrayListSize(moves);
-
-		// sort the moves if there are enough moves so sorting will be relevant
-		if (movesAmount >= MIN_MOVES_AMOUNT_TO_SORT)
-			return sortMoves(moves, movesAmount);
-	}
-
-	return SP_CHESS_GAME_SUCCESS;
+Bitboard squareAttackers(SPChessGame* game, int square, int player, Bitboard occupancy) {
+	Bitboard* pieces = game->pieces[player];
+
+	return (   (spBitboardPawnAttacks((player == BLACK_PLAYER), square) & pieces[PAWN_TYPE])
+			|  (spBitboardKnightAttacks(square)                         & pieces[KNIGHT_TYPE])
+			|  (spBitboardKingAttacks(square)                           & pieces[KING_TYPE])
+			|  (spBitboardBishopAttacks(square, occupancy)              & (pieces[BISHOP_TYPE] | pieces[QUEEN_TYPE]))
+			|  (spBitboardRookAttacks(square, occupancy)                & (pieces[ROOK_TYPE]   | pieces[QUEEN_TYPE])));
 }
 
 /**
- * The function calculates all the possible for the rook/queen that is in the given position.
- * We take advantage of the fact that the queen can move also like the rook.
- * The function calls a helper function (getDirectionalMoves) that adds all the possible moves by the relevant piece,
- * each time along a different direcional route:
- * 1) By moving vertically downwards
- * 2) By moving horizontally to the left
- * 3) By moving horizontally to the right
- * 4) By moving vertically upwards
- *
- * If the given piece is a rook we also call the helper function addPieceMove to try to add a castle move.
- *
- * The moves are added then sorted if the function is ordered to do so (The sort order is: rows from low to high as the main order,
- * and columns from low to high as a secondary order). The castle move will appear last.
+ * The function calculates all the possible moves from the a given position on the board by the given piece.
+ * The positions the piece can legally move to are taken from the bitboard that is returned from the helper function
+ * getLegalPieceMovesBitboard, and every move is added to the array list by calling the helper function addPieceMove.
+ * Because the bitboard is scanned from its least significant bit, the moves are added in a sorted way (rows from low to high
+ * as the main order, and columns from low to high as a secondary order). Castle moves (if there are possible ones) are added last.
  *
- * @param game   - A Chess game
- * @param moves  - The array list where the possible moves will be added to
- * @param srcRow - The row of the given pawn's position
- * @param srcCol - The column of the given pawn's position
- * @param sort   - Indicated if the moves that were calculated should get sorted
+ * @param game      - A Chess game
+ * @param moves     - The array list where the possible moves will be added to
+ * @param srcRow    - The row of the given piece's position
+ * @param srcCol    - The column of the given piece's position
+ * @param pieceType - The type of the given piece
+ * @param masks     - The legality masks of the current position (filled by getLegalityMasks)
+ * @param minimax   - Indicates if the moves are for the Minimax algorithm
  *
  * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove
- *										or when calling the helper function sortMoves.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise.
+ *		SP_CHESS_GAME_INVALID_ARGUMENT - If the given piece type is not a type of a Chess piece.
+ *		SP_CHESS_GAME_SUCCESS          - Otherwise.
  */
-SP_CHESS_GAME_MESSAGE getPossibleRookOrQueenMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, bool sort) {
-
-	// downwards
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, GOING_DOWNWARDS, SAME_COL) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// to the left
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, SAME_ROW       , GOING_LEFT) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	// to the right
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, SAME_ROW       , GOING_RIGHT) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
+SP_CHESS_GAME_MESSAGE getPossiblePieceMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, char pieceType, const LegalityMasks* masks, bool minimax) {
+	PIECE_TYPE type = getPieceType(pieceType);
+	if (type == NUM_OF_PIECE_TYPES)
+		return SP_CHESS_GAME_INVALID_ARGUMENT;
 
-	// upwards
-	if (getDirectionalMoves(game, moves, srcRow, srcCol, GOING_UPWARDS  , SAME_COL) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
+	Bitboard pieceMoves = getLegalPieceMovesBitboard(game, srcRow, srcCol, pieceType, masks);
 
-	if (sort) {
-		int movesAmount = spArrayListSize(moves);
+	while (pieceMoves != EMPTY_BITBOARD) {
+		int dstSquare = spBitboardPopFirstSquare(&pieceMoves);
 
-		// sort the moves if there are enough moves so sorting will be relevant
-		if ((movesAmount >= MIN_MOVES_AMOUNT_TO_SORT) && (sortMoves(moves, movesAmount) != SP_CHESS_GAME_SUCCESS))
-			return SP_CHESS_GAME_MEMORY_FAILURE;
+		addPieceMove(game, moves, srcRow, srcCol, SQUARE_ROW(dstSquare), SQUARE_COL(dstSquare), false, minimax);
 	}
 
 	/* if possible, castle move appears last (we send DUMMY_COORDINATE as the destination position's row and column because we
 	   don't use the fields dstRow and dstCol of the move structure when setting a castle move) */
-	char piece = game->board[srcRow][srcCol];
-	if (   ((piece == WHITE_ROOK) || (piece == BLACK_ROOK))
-		&& (addPieceMove(game, moves, srcRow, srcCol, DUMMY_COORDINATE, DUMMY_COORDINATE, true, false) == SP_CHESS_GAME_MEMORY_FAILURE)) {
+	if (type == ROOK_TYPE)
+		addPieceMove(game, moves, srcRow, srcCol, DUMMY_COORDINATE, DUMMY_COORDINATE, true, false);
 
-				return SP_CHESS_GAME_MEMORY_FAILURE;
+	// king castle moves
+	if (type == KING_TYPE) {
+		if (game->currentPlayer == WHITE_PLAYER)
+			getPossibleKingCastleMoves(game, moves, WHITE_ROOK, WHITE_FIRST_ROW);
+		else
+			getPossibleKingCastleMoves(game, moves, BLACK_ROOK, BLACK_FIRST_ROW);
 	}
 
 	return SP_CHESS_GAME_SUCCESS;
 }
 
 /**
- * The function calculates all the possible for the given piece along the given direction.
- * We do this checking by starting from the given position and going sqaure-by-square on the given game board,
- * according to the given direction: the move is added at the time we get to a new position, and the itereation
- * that represnetd the square-by-square walk stops when it either reached an invalid position or when it encountered
- * a non empty position. The non empty position is added as destination position to move to only if the piece in that
- * position belongs to the rival (otherwise it would be illegal for the piece to move there).
+ * The function adds all the possible moves of the current player to play to the given array, by calling for each of the player's
+ * pieces the helper function getPackedPieceMoves (in its "captures-only" mode, when only the captures and the pawn promotions are
+ * needed). The pieces are taken type by type from the bitboards of the player (the piece list of every type), that is much cheaper
+ * than scanning the board: only the live pieces are visited, and neither the board nor the type of a piece is read.
+ * This is the move generator of the Minimax algorithm and of the perft tool (see SPChessPerft).
  *
- * @param game     - A Chess game
- * @param moves    - The array list where the possible moves will be added to
- * @param srcRow   - The row of the position where the given piece is currently at
- * @param srcCol   - The column of the position where the given piece is currently at
- * @param deltaRow - The movement in terms of row that should be made when going to the next position sqare-by-square:
- * 					  Either one row up, one row down or staying at the same row
- * @param deltaCol - The movement in terms of column that should be made when going to the next position sqare-by-square:
- * 					   Either one column up, one column down or staying at the same column
+ * @param game         - A Chess game
+ * @param moves        - The array where the possible moves will be added to (its size is MAX_POSITION_MOVES)
+ * @param masks        - The legality masks of the current position (filled by getLegalityMasks)
+ * @param capturesOnly - Indicates if only the captures and the pawn promotions should be added
  *
  * @return
- * 		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove.
- *      SP_CHESS_GAME_SUCCESS        - Otherwise.
+ *		The number of moves that were added to the array.
  */
-SP_CHESS_GAME_MESSAGE getDirectionalMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, int deltaRow, int deltaCol) {
-	// the first position to check
-	int currRowToCheck = (srcRow + deltaRow);
-	int currColToCheck = (srcCol + deltaCol);
-
-	char dstPiece = EMPTY_POSITION; // default value to ensure it is initialized
-
-	bool keepGoing = validPosition(currRowToCheck, currColToCheck);
-
-	/* We advance along the direction, advancing by deltaRow rows and deltaCol columns in each iteration.
-	   We will once we no longer hit an empty square or when we reache an invalid position */
-	while (keepGoing) {
-		dstPiece = game->board[currRowToCheck][currColToCheck];
-
-		if (dstPiece != EMPTY_POSITION)
-			break;
-
-		if (addPieceMove(game, moves, srcRow, srcCol, currRowToCheck, currColToCheck, false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-			return SP_CHESS_GAME_MEMORY_FAILURE;
+int getPossiblePackedMoves(SPChessGame* game, PackedMove moves[], const LegalityMasks* masks, bool capturesOnly) {
+	int currPlayer = game->currentPlayer;
+	int numOfMoves = 0;
 
-		currRowToCheck += deltaRow;
-		currColToCheck += deltaCol;
+	for (int type = 0; type < NUM_OF_PIECE_TYPES; type++) {
+		Bitboard pieces = game->pieces[currPlayer][type];
+		char     piece  = getPlayerPiece(currPlayer, type);
 
-		keepGoing = validPosition(currRowToCheck, currColToCheck);
+		while (pieces != EMPTY_BITBOARD)
+			numOfMoves += getPackedPieceMoves(game, &(moves[numOfMoves]), spBitboardPopFirstSquare(&pieces), piece, masks, capturesOnly);
 	}
 
-	// If the reason we stopped iterating was we encountered an enemy piece, we might get an additional move: an "eating" move.
-	if ((dstPiece != EMPTY_POSITION) && rivalPiece(game->currentPlayer, dstPiece))
-		return addPieceMove(game, moves, srcRow, srcCol, currRowToCheck, currColToCheck, false, false);
-
-	return SP_CHESS_GAME_SUCCESS;
+	return numOfMoves;
 }
 
 /**
- * The function sorts the given array list of moves. The sorting method is the famous "Bubble Sort" according
- * to the move's destination position, while sort order is:
- * Rows from low to high as the main order, and columns from low to high as a secondary order.
- *
- * @param moves       - The array list where the possible moves will be added to
- * @param movesAmount - The number of moves to sort in the array list
+ * The function calculates the possible moves from a given position on the board by the given piece as packed moves
+ * (see SPChessPackedMove), that are used by the Minimax algorithm instead of the move structures of the array list.
+ * As in getPossiblePieceMoves, the positions the piece can legally move to are taken from the bitboard that is returned from
+ * the helper function getLegalPieceMovesBitboard. In the "captures-only" generation mode (that is used by the quiescence search)
+ * only the positions of the rival's pieces (and, for a pawn, the positions of the last row, where its moves are promotions) are kept.
+ * All the possible promotions are added for a pawn promotion move (first the queen, then the rook, the bishop and the knight).
+ * A castle move is added only by its rook (the castle moves of the king are the same moves), and never in the "captures-only" mode.
+ *
+ * @param game         - A Chess game
+ * @param moves        - The array where the possible moves will be added to (from its beginning)
+ * @param srcSquare    - The square of the given piece's position
+ * @param piece        - The given piece (a piece of the current player)
+ * @param masks        - The legality masks of the current position (filled by getLegalityMasks)
+ * @param capturesOnly - Indicates if only the captures and the pawn promotions should be added
  *
  * @return
- * 		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred furing the execution of the function.
- *      SP_CHESS_GAME_SUCCESS        - Otherwise.
+ *		The number of moves that were added to the array.
  */
-SP_CHESS_GAME_MESSAGE sortMoves(SPArrayList* moves, int movesAmount) {
-	Move *moveA, *moveB;
-	bool swaped;
-
-	for (int i = 0; i < (movesAmount-1); i++) {
-		swaped = false;
-
-		for (int j = 0; j < (movesAmount-1); j++) {
-			moveA = spMoveCopy(spArrayListGetAt(moves, j));
-			if (moveA == NULL)
-				return SP_CHESS_GAME_MEMORY_FAILURE;
+int getPackedPieceMoves(SPChessGame* game, PackedMove moves[], int srcSquare, char piece, const LegalityMasks* masks, bool capturesOnly) {
+	PIECE_TYPE type       = getPieceType(piece);
+	int        srcRow     = SQUARE_ROW(srcSquare);
+	int        srcCol     = SQUARE_COL(srcSquare);
+	int        numOfMoves = 0;
+	Bitboard   promotions = EMPTY_BITBOARD;
+
+	// a pawn is promoted at the first row of the rival
+	if (type == PAWN_TYPE) {
+		int promotionRow = (game->currentPlayer == WHITE_PLAYER) ? BLACK_FIRST_ROW : WHITE_FIRST_ROW;
+		promotions = (FIRST_ROW_BITBOARD << (promotionRow * BITBOARD_ROW_LENGTH));
+	}
 
-			moveB = spArrayListGetAt(moves, j+1);
+	Bitboard pieceMoves = getLegalPieceMovesBitboard(game, srcRow, srcCol, piece, masks);
+	if (capturesOnly)
+		pieceMoves &= (game->occupancy[!(game->currentPlayer)] | promotions);
 
-			if (   (moveA->dstRow > moveB->dstRow)
-			    || ((moveA->dstRow == moveB->dstRow) && (moveA->dstCol > moveB->dstCol))) {
+	while (pieceMoves != EMPTY_BITBOARD) {
+		int dstSquare = spBitboardPopFirstSquare(&pieceMoves);
 
-						spArrayListRemoveAt(moves, j);
-						spArrayListAddAt(moves, moveA, j+1);
-						swaped = true;
-			}
-			free(moveA);
+		if (SQUARE_BITBOARD(dstSquare) & promotions) {
+			for (int promotionType = QUEEN_TYPE; promotionType > PAWN_TYPE; promotionType--)
+				moves[numOfMoves++] = spPackedMoveCreate(srcSquare, dstSquare, (PIECE_TYPE) promotionType);
 		}
-
-		if (!swaped)
-			return SP_CHESS_GAME_SUCCESS;
+		else
+			moves[numOfMoves++] = spPackedMoveCreate(srcSquare, dstSquare, PAWN_TYPE);
 	}
 
-	return SP_CHESS_GAME_SUCCESS;
-}
-
-/**
- * The function calculates all the possible for the king that is in the given position.
- * Every move is added to the array list by calling the helper function addPieceMove.
- * The moves are added in a sorted way (rows from low to high as the main order,
- * and columns from low to high as a secondary order), and castle moves (if there are possible ones) are added last.
- *
- * @param game   - A Chess game
- * @param moves  - The array list where the possible moves will be added to
- * @param srcRow - The row of the given pawn's position
- * @param srcCol - The column of the given pawn's position
- *
- * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise.
- */
-SP_CHESS_GAME_MESSAGE getPossibleKingMoves(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol) {
-
-	// All the 8 moves that might be possible by a king sorted according to what is explained above
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 1), (srcCol - 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 1),  srcCol     , false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow - 1), (srcCol + 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol,  srcRow     , (srcCol - 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol,  srcRow     , (srcCol + 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 1), (srcCol - 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 1),  srcCol     , false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
+	if ((type == ROOK_TYPE) && !capturesOnly) {
+		Move castle;
+		castle.srcRow   = srcRow;
+		castle.srcCol   = srcCol;
+		castle.srcPiece = piece;
 
-	if (addPieceMove(game, moves, srcRow, srcCol, (srcRow + 1), (srcCol + 1), false, false) == SP_CHESS_GAME_MEMORY_FAILURE)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
+		if (legalCastle(game, &castle))
+			moves[numOfMoves++] = spPackedMoveCreateCastle(srcSquare);
+	}
 
-	// king castle moves
-	if (game->currentPlayer == WHITE_PLAYER)
-		return getPossibleKingCastleMoves(game, moves, WHITE_ROOK, WHITE_FIRST_ROW);
-	else
-		return getPossibleKingCastleMoves(game, moves, BLACK_ROOK, BLACK_FIRST_ROW);
+	return numOfMoves;
 }
 
 /**
@@ -1439,34 +1335,23 @@ SP_CHESS_GAME_MESSAGE getPossibleKingMoves(SPChessGame* game, SPArrayList* moves
  * @param moves          - The array list where the possible moves will be added to
  * @param pieceType      - The type of king that we try to find for it possible castle moves
  * @param playerFirstRow - The "first rank" on board of the player that plays a move (helps to figure out if the king is at its original position)
- *
- * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise.
  */
-SP_CHESS_GAME_MESSAGE getPossibleKingCastleMoves(SPChessGame* game, SPArrayList* moves, int pieceType, int playerFirstRow) {
+void getPossibleKingCastleMoves(SPChessGame* game, SPArrayList* moves, int pieceType, int playerFirstRow) {
 	/* first left castle (we send DUMMY_COORDINATE as the destination position's row and column because we
 	   don't use the fields dstRow and dstCol of the move structure when setting a castle move) */
-	if (   (game->board[playerFirstRow][LEFT_ROOK_COL] == pieceType)
-		&& (addPieceMove(game, moves, playerFirstRow, LEFT_ROOK_COL , DUMMY_COORDINATE, DUMMY_COORDINATE, true, false) == SP_CHESS_GAME_MEMORY_FAILURE)) {
-
-				return SP_CHESS_GAME_MEMORY_FAILURE;
-	}
+	if (game->board[playerFirstRow][LEFT_ROOK_COL] == pieceType)
+		addPieceMove(game, moves, playerFirstRow, LEFT_ROOK_COL , DUMMY_COORDINATE, DUMMY_COORDINATE, true, false);
 
 	/* then right castle (we send DUMMY_COORDINATE as the destination position's row and column because we
 	   don't use the fields dstRow and dstCol of the move structure when setting a castle move) */
-	if (   (game->board[playerFirstRow][RIGHT_ROOK_COL] == pieceType)
-		&& (addPieceMove(game, moves, playerFirstRow, RIGHT_ROOK_COL, DUMMY_COORDINATE, DUMMY_COORDINATE, true, false) == SP_CHESS_GAME_MEMORY_FAILURE)) {
-
-				return SP_CHESS_GAME_MEMORY_FAILURE;
-	}
-
-	return SP_CHESS_GAME_SUCCESS;
+	if (game->board[playerFirstRow][RIGHT_ROOK_COL] == pieceType)
+		addPieceMove(game, moves, playerFirstRow, RIGHT_ROOK_COL, DUMMY_COORDINATE, DUMMY_COORDINATE, true, false);
 }
 
 /**
- * The function creates a move structure according to the parameters it receives, and after verifying the move is
- * legal - adds it to the given array list.
+ * The function fills a move structure according to the parameters it receives, and adds it to the given array list
+ * (if it is a castle move, only after verifying it is legal). The move is filled on the stack and copied into the list,
+ * so no memory is allocated for it.
  * If the move would be a pawn promotion move (that was received from the Minimax algorithm), the function calls to the helper function
  * addPawnPromotionsMoves in order to add all the possible promotions as possible moves.
  *
@@ -1477,113 +1362,64 @@ SP_CHESS_GAME_MESSAGE getPossibleKingCastleMoves(SPChessGame* game, SPArrayList*
  * @param dstRow  - The row of the position where the given piece is going to move to
  * @param dstCol  - The column of the position where the given piece is going to move to
  * @param castle  - indicates if the move that we try to add is a castle move
- * @param minimax - Indicates if the move is for the Minimax algorithm
+ * @param minimax - Indicates if the move is for the Minimax algorithm (then the move doesn't get the indicators that only inform the user)
  *
- * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise (even if the move was not added - not adding the move is ok if it not because of memory failure.
+ * @precondition - If the move is not a castle move, the destination position is one of the positions
+ *                  that are returned from getLegalPieceMovesBitboard for the given piece
  */
-SP_CHESS_GAME_MESSAGE addPieceMove(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, int dstRow, int dstCol, bool castle, bool minimax) {
-	if (!castle && !validPosition(dstRow, dstCol))
-		return SP_CHESS_GAME_SUCCESS;
-
-	Move* move = spCreateMove();
-	if (move == NULL)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
+void addPieceMove(SPChessGame* game, SPArrayList* moves, int srcRow, int srcCol, int dstRow, int dstCol, bool castle, bool minimax) {
+	Move move;
 
-	move->srcRow   = srcRow;
-	move->srcCol   = srcCol;
-	move->srcPiece = game->board[srcRow][srcCol];
+	move.srcRow              = srcRow;
+	move.srcCol              = srcCol;
+	move.srcPiece            = game->board[srcRow][srcCol];
+	move.castleMove          = false;
+	move.pawnPromotion       = false;
+	move.dstPieceCaptured    = false;
+	move.threatenedAfterMove = false;
 
 	if (castle) {
-		if (!legalCastle(game, move)) {
-			free(move);
-			return SP_CHESS_GAME_SUCCESS;
-		}
+		if (!legalCastle(game, &move))
+			return;
 
-		move->castleMove = true;
+		move.castleMove = true;
 	}
 	else {
-		move->dstRow   = dstRow;
-		move->dstCol   = dstCol;
+		move.dstRow           = dstRow;
+		move.dstCol           = dstCol;
+		move.dstPiece         = game->board[dstRow][dstCol];
+		move.dstPieceCaptured = (move.dstPiece != EMPTY_POSITION);
 
-		if (!legalRegularMove(game, move)) {
-			free(move);
-			return SP_CHESS_GAME_SUCCESS;
-		}
+		updateMoveIndicators(game, &move);
+
+		// the moves for the Minimax algorithm are "bare" moves, without the indicators that are used only to inform the user
+		if (!minimax)
+			updateMoveAnnotations(game, &move);
 
 		// adding all the possible promotions as possible moves for the Minimax algorithm
-		if (minimax && (move->pawnPromotion)) {
-			SP_CHESS_GAME_MESSAGE message = addPawnPromotionsMoves(moves, move, game->currentPlayer);
-			free(move);
-			return message;
+		if (minimax && (move.pawnPromotion)) {
+			addPawnPromotionsMoves(moves, &move, game->currentPlayer);
+			return;
 		}
 	}
 
-	spArrayListAddLast(moves, move);
-	free(move);
-
-	return SP_CHESS_GAME_SUCCESS;
+	spArrayListAddLast(moves, &move);
 }
 
 /**
- * The function adds all the possible promotions as possible moves to the given array list.
- * According to the current player to plays the move, we choose the types of queen/rook/bishop/knight that the pawn will be promoted to.
+ * The function adds all the possible promotions as possible moves to the given array list (first the queen,
+ * then the rook, the bishop and the knight). According to the current player to plays the move, we choose the
+ * types of queen/rook/bishop/knight that the pawn will be promoted to.
  *
  * @param moves      - The array list where the possible moves will be added to
- * @param move       - The move details that each pawn promtion move will get its details from
+ * @param move       - The move details that each pawn promtion move will get its details from (its source piece is changed)
  * @param currPlayer - The current player to make a move
- *
- * @return
- *		SP_CHESS_GAME_MEMORY_FAILURE - If a memory failure occurred in one of the calls to the helper function addPieceMove.
- *		SP_CHESS_GAME_SUCCESS        - Otherwise (even if the move was not added - not adding the move is ok if it not because of memory failure).
  */
-SP_CHESS_GAME_MESSAGE addPawnPromotionsMoves(SPArrayList* moves, Move* move, char currPlayer) {
-	char queenType  = (currPlayer == WHITE_PLAYER) ? WHITE_QUEEN  : BLACK_QUEEN;
-	char rookType   = (currPlayer == WHITE_PLAYER) ? WHITE_ROOK   : BLACK_ROOK;
-	char bishopType = (currPlayer == WHITE_PLAYER) ? WHITE_BISHOP : BLACK_BISHOP;
-	char knightType = (currPlayer == WHITE_PLAYER) ? WHITE_KNIGHT : BLACK_KNIGHT;
-
-	// pawn promotion to queen
-	Move* queenMove = spMoveCopy(move);
-	if (queenMove == NULL)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	queenMove->srcPiece = queenType;
-	spArrayListAddLast(moves, queenMove);
-	free(queenMove);
-
-
-	// pawn promotion to rook
-	Move* rookMove = spMoveCopy(move);
-	if (rookMove == NULL)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	rookMove->srcPiece = rookType;
-	spArrayListAddLast(moves, rookMove);
-	free(rookMove);
-
-
-	// pawn promotion to bishop
-	Move* bishopMove = spMoveCopy(move);
-	if (bishopMove == NULL)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	bishopMove->srcPiece = bishopType;
-	spArrayListAddLast(moves, bishopMove);
-	free(bishopMove);
-
-
-	// pawn promotion to knight
-	Move* knightMove = spMoveCopy(move);
-	if (knightMove == NULL)
-		return SP_CHESS_GAME_MEMORY_FAILURE;
-
-	knightMove->srcPiece = knightType;
-	spArrayListAddLast(moves, knightMove);
-	free(knightMove);
-
-	return SP_CHESS_GAME_SUCCESS;
+void addPawnPromotionsMoves(SPArrayList* moves, Move* move, char currPlayer) {
+	for (int promotionType = QUEEN_TYPE; promotionType > PAWN_TYPE; promotionType--) {
+		move->srcPiece = getPlayerPiece(currPlayer, (PIECE_TYPE) promotionType);
+		spArrayListAddLast(moves, move);
+	}
 }
 
 /**
@@ -1645,20 +1481,71 @@ bool rivalPiece(int currPlayer, char piece) {
 }
 
 /**
- * The function checks if the given position is occupied by the given piece.
- * Before checking if the piece ocuupies the position we first check if it valid by calling the helper function validPosition.
+ * The function returns the type of the given piece regardless of its color (used as an index to the bitboards of the game).
  *
- * @param board - The current Chess game board
- * @param row   - The row of the given position
- * @param col   - The column of the given position
- * @param piece - The piece that we check if it occupies the given position
+ * @param piece - The piece that its type is returned
  *
  * @return
- *		True  - If given piece is occupying the given position.
- *		False - Otherwise.
+ *		The type of the given piece, or NUM_OF_PIECE_TYPES if it is not a Chess piece (e.g. EMPTY_POSITION).
+ */
+PIECE_TYPE getPieceType(char piece) {
+	switch (piece) {
+		case WHITE_PAWN:
+		case BLACK_PAWN:
+			return PAWN_TYPE;
+
+		case WHITE_KNIGHT:
+		case BLACK_KNIGHT:
+			return KNIGHT_TYPE;
+
+		case WHITE_BISHOP:
+		case BLACK_BISHOP:
+			return BISHOP_TYPE;
+
+		case WHITE_ROOK:
+		case BLACK_ROOK:
+			return ROOK_TYPE;
+
+		case WHITE_QUEEN:
+		case BLACK_QUEEN:
+			return QUEEN_TYPE;
+
+		case WHITE_KING:
+		case BLACK_KING:
+			return KING_TYPE;
+
+		default:
+			return NUM_OF_PIECE_TYPES;
+	}
+}
+
+/**
+ * The function returns the piece of the given type that belongs to the given player (the opposite of getPieceType).
+ *
+ * @param player - The player that the piece belongs to
+ * @param type   - The type of the piece (not NUM_OF_PIECE_TYPES)
+ *
+ * @return
+ *		The piece of the given type and player.
+ */
+char getPlayerPiece(int player, PIECE_TYPE type) {
+	static const char whitePieces[NUM_OF_PIECE_TYPES] = { WHITE_PAWN, WHITE_KNIGHT, WHITE_BISHOP, WHITE_ROOK, WHITE_QUEEN, WHITE_KING };
+	static const char blackPieces[NUM_OF_PIECE_TYPES] = { BLACK_PAWN, BLACK_KNIGHT, BLACK_BISHOP, BLACK_ROOK, BLACK_QUEEN, BLACK_KING };
+
+	return ((player == WHITE_PLAYER) ? whitePieces[type] : blackPieces[type]);
+}
+
+/**
+ * The function returns the player that the given piece belongs to.
+ *
+ * @param piece - A Chess piece (not EMPTY_POSITION)
+ *
+ * @return
+ *		WHITE_PLAYER - If the given piece is a white piece.
+ *		BLACK_PLAYER - Otherwise.
  */
-bool pieceOccupyingPosition(char board[][BOARD_LENGTH], int row, int col, char piece) {
-	return ((validPosition(row, col)) && (board[row][col] == piece));
+int pieceOwner(char piece) {
+	return (currentPlayerPiece(WHITE_PLAYER, piece) ? WHITE_PLAYER : BLACK_PLAYER);
 }
 
 /**
@@ -1,5 +1,25 @@
 #include "SPChessGameWindow.h"
 
+/**
+ * The type of the SDL user event that the computer's search thread posts when its move is ready
+ * (registered once, when the gui mode starts, by gameWindowRegisterEvents).
+ */
+static Uint32 computerMoveEventType = UNREGISTERED_EVENT_TYPE;
+
+/**
+ * The function registers the SDL user event that is posted when the computer's move is ready. It should be called once,
+ * after SDL is initialized and before any Game window is created.
+ *
+ * @return
+ * 		True  - If the event was registered.
+ * 		False - If SDL has no more user events to register.
+ */
+bool gameWindowRegisterEvents(void) {
+	computerMoveEventType = SDL_RegisterEvents(1);
+
+	return (computerMoveEventType != UNREGISTERED_EVENT_TYPE);
+}
+
 /**
  * The function creates the Game window in the gui mode.
  *
@@ -64,6 +84,10 @@ SPGameWindow* gameWindowCreate(GameSetting* settings) {
 	gameWindow->actualNumOfWidgets = GAME_WINDOW_TOTAL_WIDGETS;
 	gameWindow->firstCreated       = true;
 	gameWindow->gameIsSaved        = false;
+	gameWindow->computerThread     = NULL;
+	gameWindow->computerGame       = NULL;
+	gameWindow->computerMove       = NULL;
+	SDL_AtomicSet(&(gameWindow->computerMoveDone), 0);
 
 	return gameWindow;
 }
@@ -290,7 +314,7 @@ void gameWindowDraw(SPGameWindow* gameWindow, bool updateBoard) {
 	SPWidget**   widgets   = gameWindow->widgets;
 
 	if (updateBoard) { // If needed, updates the game board on the screen
-		if (   (gameWindow->settings->gameMode == ONE_PLAYER_MODE)
+		if (   (gameWindow->settings->gameMode == ONE_PLAYER_MODE) && (gameWindow->computerThread == NULL)
 			&& spChessGameIsUndoPossible(gameWindow->settings->game, gameWindow->settings->userColor)) {
 
 				((SPButton*) gameWindow->widgets[UNDO_INDEX]->data)->isActive = true; // in case there an undo is possible we activate it
@@ -446,13 +470,17 @@ void drawPossibleMoves(SPGameWindow* gameWindow) {
  *
  * @return
  * 		SP_GAME_EVENT_EXIT - If the "X" button (at the window's corner) was clicked.
- * 		Otherwise          - Returns the SP_GAME_EVENT that returned from the relevant helper function if a "MOUSEBUTTONUP" event or
- * 		                      a "MOUSEBUTTONDOWN" event occurred. If non of them occurred, returns SP_GAME_EVENT_NONE as a default value.
+ * 		Otherwise          - Returns the SP_GAME_EVENT that returned from the relevant helper function if a "MOUSEBUTTONUP" event,
+ * 		                      a "MOUSEBUTTONDOWN" event or the event of a ready computer move occurred. If non of them occurred,
+ * 		                      returns SP_GAME_EVENT_NONE as a default value.
  */
 SP_GAME_EVENT gameWindowHandleEvent(SPGameWindow* gameWindow, SDL_Event* event) {
 	if ((gameWindow == NULL) || (event == NULL))
 		return SP_GAME_EVENT_INVALID_ARGUMENT;
 
+	if (event->type == computerMoveEventType) // the event type is registered at runtime, so it can't be a case of the switch
+		return handleComputerMoveEvent(gameWindow);
+
 	switch (event->type) {
 		case SDL_MOUSEBUTTONUP:
 			return handleEventMouseButtonUp(gameWindow, event);
@@ -496,9 +524,10 @@ SP_GAME_EVENT handleEventMouseButtonUp(SPGameWindow* gameWindow, SDL_Event* even
 	SPWidget* exitWidget     = gameWindow->widgets[EXIT_INDEX_GAME];
 
 	if (restartWidget->handleEvent(restartWidget, event)) {
+		cancelComputerMove(gameWindow); // the computer may be thinking on the game that is restarted
 		spChessGameDestroy(gameWindow->settings->game);
 		gameWindow->settings->game = NULL;
-		gameWindow->settings->game = spChessGameCreate(HISTORY_SIZE);
+		gameWindow->settings->game = spChessGameCreate();
 
 		gameWindow->gameIsSaved = false;
 		return SP_GAME_EVENT_RESET_GAME;
@@ -513,15 +542,19 @@ SP_GAME_EVENT handleEventMouseButtonUp(SPGameWindow* gameWindow, SDL_Event* even
 	}
 
 	if (undoWidget->handleEvent(undoWidget, event)) {
-		if ((gameWindow->settings->gameMode == ONE_PLAYER_MODE) && (((SPButton*) gameWindow->widgets[UNDO_INDEX]->data)->isActive)) {
-			// undoes the last user's move
-			Move* userMove = spArrayListGetLast(gameWindow->settings->game->history);
-			spChessGameUndoPrevMove(gameWindow->settings->game, userMove);
+		if (   (gameWindow->settings->gameMode == ONE_PLAYER_MODE) && (gameWindow->computerThread == NULL)
+			&& (((SPButton*) gameWindow->widgets[UNDO_INDEX]->data)->isActive)) {
+
+			// the computer ponders on a position that is undone
+			cancelComputerMove(gameWindow);
 
 			// undoes the last computer's move
-			Move* computerMove = spArrayListGetLast(gameWindow->settings->game->history);
-			spChessGameUndoPrevMove(gameWindow->settings->game, computerMove);
+			spChessGameUndoPrevMove(gameWindow->settings->game, NULL);
 
+			// undoes the last user's move
+			spChessGameUndoPrevMove(gameWindow->settings->game, NULL);
+
+			gameWindowPonder(gameWindow);
 			gameWindow->gameIsSaved = false;
 			return SP_GAME_EVENT_UPDATE;
 		}
@@ -545,11 +578,14 @@ SP_GAME_EVENT handleEventMouseButtonUp(SPGameWindow* gameWindow, SDL_Event* even
  * @param event      - A pointer the current "MOUSEBUTTONDOWN" event
  *
  * @return
- * 		SP_GAME_EVENT_NONE   - If an illegal piece was clicked or if a right click occured.
+ * 		SP_GAME_EVENT_NONE   - If an illegal piece was clicked, if a right click occured or if the computer is thinking.
  * 		SP_GAME_EVENT_EXIT   - If after proccesing the event the game is finished.
  * 		SP_GAME_EVENT_UPDATE - Otherwise.
  */
 SP_GAME_EVENT handleEventMouseButtonDown(SPGameWindow* gameWindow, SDL_Event* event) {
+	if (gameWindow->computerThread != NULL) // the board is locked while the computer is thinking on its move
+		return SP_GAME_EVENT_NONE;
+
 	SPWidget* pieceWidget = NULL;
 	Move* userMove = spCreateMove();
 
@@ -798,13 +834,13 @@ bool isPawnPromotionMemoryFailling(SPChessGame* game, Move* userMove) {
 /**
  * The function checks if the game is finished (in the "One Player" mode):
  * If it did - prompts a relevant message, if it didn't - calls to
- * a helper function tp execute the next computer move.
+ * a helper function to start the search of the next computer move.
  *
  * @param gmaWindow - The Game window of the program
  *
  * @return
  * 		SP_GAME_EVENT_EXIT - If the game is finished
- * 		Otherwise          - Returns what came back from the helper function executeCompterMove.
+ * 		Otherwise          - Returns what came back from the helper function startComputerMove.
  */
 SP_GAME_EVENT gameFinishedOnePlayersMode(SPGameWindow* gameWindow) {
 	GAME_STATUS gameStatus = gameWindow->settings->game->status;
@@ -829,24 +865,177 @@ SP_GAME_EVENT gameFinishedOnePlayersMode(SPGameWindow* gameWindow) {
 			break;
 	}
 
-	return executeCompterMove(gameWindow);
+	return startComputerMove(gameWindow);
+}
+
+/**
+ * The function starts the search of the computer's next move on a thread of its own, so the window keeps handling its events
+ * (it is repainted, and it can be closed) while the computer is thinking. The thread searches a copy of the game, and when its
+ * move is ready it posts an event that is handled by the helper function handleComputerMoveEvent, on the gui thread.
+ * Until then the title of the window shows that the computer is thinking, and the board and the "Undo" button are locked.
+ *
+ * @param gameWindow - The Game window of the program
+ *
+ * @return
+ * 		SP_GAME_EVENT_QUIT   - If a memory error occurred (or the thread couldn't be created).
+ * 		SP_GAME_EVENT_UPDATE - Otherwise.
+ */
+SP_GAME_EVENT startComputerMove(SPGameWindow* gameWindow) {
+	gameWindow->computerGame = spChessGameCopy(gameWindow->settings->game);
+	if (gameWindow->computerGame == NULL) {
+		MEMORY_ALLOCATION_PERROR;
+		return SP_GAME_EVENT_QUIT;
+	}
+
+	gameWindow->computerMove = NULL;
+	SDL_AtomicSet(&(gameWindow->computerMoveDone), 0);
+
+	gameWindow->computerThread = SDL_CreateThread(computerMoveSearch, COMPUTER_THREAD_NAME, gameWindow);
+	if (gameWindow->computerThread == NULL) {
+		spChessGameDestroy(gameWindow->computerGame);
+		gameWindow->computerGame = NULL;
+		printf(THREAD_CREATION_ERROR, SDL_GetError());
+		return SP_GAME_EVENT_QUIT;
+	}
+
+	SDL_SetWindowTitle(gameWindow->window, COMPUTER_THINKING_TITLE);
+	return SP_GAME_EVENT_UPDATE;
+}
+
+/**
+ * The start routine of the thread that searches the computer's move (see startComputerMove).
+ * The gui thread doesn't touch the searched copy of the game nor the settings of the game until the thread is done,
+ * and it reads the move only after waiting for the thread.
+ *
+ * @param data - The Game window of the program
+ *
+ * @return
+ * 		0 (the move is kept in the Game window).
+ */
+int computerMoveSearch(void* data) {
+	SPGameWindow* gameWindow = (SPGameWindow*) data;
+	GameSetting*  settings   = gameWindow->settings;
+
+	gameWindow->computerMove = spChessMinimaxMove(gameWindow->computerGame, settings->difficulty, settings->searchThreads);
+	SDL_AtomicSet(&(gameWindow->computerMoveDone), 1);
+
+	SDL_Event event;
+	SDL_zero(event);
+	event.type = computerMoveEventType;
+	SDL_PushEvent(&event);
+
+	return 0;
+}
+
+/**
+ * The function handles the event that is posted when the computer's move is ready: the search thread is waited for,
+ * and its move is executed by calling the helper function executeCompterMove.
+ *
+ * @param gameWindow - The Game window of the program
+ *
+ * @return
+ * 		SP_GAME_EVENT_NONE - If the computer is not thinking (a late event of a cancelled search).
+ * 		Otherwise          - Returns what came back from the helper function executeCompterMove.
+ */
+SP_GAME_EVENT handleComputerMoveEvent(SPGameWindow* gameWindow) {
+	if (gameWindow->computerThread == NULL)
+		return SP_GAME_EVENT_NONE;
+
+	return executeCompterMove(gameWindow, joinComputerMove(gameWindow));
+}
+
+/**
+ * The function waits for the thread that searches the computer's move to finish, and frees its copy of the game.
+ *
+ * @param gameWindow - The Game window of the program
+ *
+ * @precondition - The computer is thinking (gameWindow->computerThread is not NULL)
+ *
+ * @return
+ * 		The move that was found by the thread (NULL if a memory error occurred during the search).
+ */
+Move* joinComputerMove(SPGameWindow* gameWindow) {
+	SDL_WaitThread(gameWindow->computerThread, NULL);
+	gameWindow->computerThread = NULL;
+
+	spChessGameDestroy(gameWindow->computerGame);
+	gameWindow->computerGame = NULL;
+
+	Move* computerMove = gameWindow->computerMove;
+	gameWindow->computerMove = NULL;
+
+	SDL_SetWindowTitle(gameWindow->window, GAME_TITLE);
+	return computerMove;
+}
+
+/**
+ * The function cancels the search of the computer's move (if the computer is thinking) and its pondering on the user's time
+ * (if it ponders), when the game it searches is about to be restarted, replaced or destroyed. The search is stopped again and
+ * again until its thread is done, because a stop that comes before the search has started would be missed. The move of the
+ * cancelled search is ignored, and so is its event (which is removed from the event queue, if it was already posted).
+ *
+ * @param gameWindow - The Game window of the program
+ */
+void cancelComputerMove(SPGameWindow* gameWindow) {
+	if (gameWindow->computerThread != NULL) {
+		while (!SDL_AtomicGet(&(gameWindow->computerMoveDone))) {
+			spChessMinimaxStop();
+			SDL_Delay(COMPUTER_CANCEL_DELAY_MS);
+		}
+
+		free(joinComputerMove(gameWindow));
+		SDL_FlushEvent(computerMoveEventType);
+	}
+
+	// only after the search's thread is done, because the search itself stops the pondering first
+	spChessMinimaxPonderStop();
+}
+
+/**
+ * The function starts the computer's pondering on the user's time (see spChessMinimaxPonderStart), if it's the user's turn
+ * to play in the "One Player" mode. The pondering is stopped by the computer's next search, or by cancelComputerMove.
+ *
+ * @param gameWindow - The Game window of the program
+ */
+void gameWindowPonder(SPGameWindow* gameWindow) {
+	GameSetting* settings = gameWindow->settings;
+
+	if ((settings->gameMode == ONE_PLAYER_MODE) && (settings->game->currentPlayer == settings->userColor))
+		spChessMinimaxPonderStart(settings->game, settings->difficulty, settings->searchThreads);
+}
+
+/**
+ * The function checks if it's the computer's turn to play in a game that is not finished yet (in the "One Player" mode).
+ *
+ * @param gameWindow - The Game window of the program
+ *
+ * @return
+ * 		True  - If it's the computer's turn to play.
+ * 		False - Otherwise.
+ */
+bool gameWindowComputerTurn(SPGameWindow* gameWindow) {
+	GameSetting* settings = gameWindow->settings;
+	GAME_STATUS  status   = settings->game->status;
+
+	return (   (settings->gameMode == ONE_PLAYER_MODE) && (settings->game->currentPlayer != settings->userColor)
+			&& ((status == GAME_NOT_FINISHED_CHECK) || (status == GAME_NOT_FINISHED_NO_CHECK)));
 }
 
 /**
  * The function executes the computer move chosen by the Minimax algorithm,
  * and if after it the game is finished - prompts a relevant message.
  *
- * @param gmaWindow - The Game window of the program
+ * @param gmaWindow    - The Game window of the program
+ * @param computerMove - The move that was found by the search of the computer (NULL if a memory error occurred)
  *
  * @return
  *		SP_GAME_EVENT_QUIT   - If a memory error occurred.
  *		SP_GAME_EVENT_EXIT   - If the compter's move finished the game.
  *		SP_GAME_EVENT_UPDATE - Otherwise.
  */
-SP_GAME_EVENT executeCompterMove(SPGameWindow* gameWindow) {
+SP_GAME_EVENT executeCompterMove(SPGameWindow* gameWindow, Move* computerMove) {
 	SPChessGame* game = gameWindow->settings->game;
 
-	Move* computerMove = spChessMinimaxMove(game, gameWindow->settings->difficulty);
 	if (computerMove == NULL) {
 		MEMORY_ALLOCATION_PERROR;
 		return SP_GAME_EVENT_QUIT;
@@ -855,6 +1044,7 @@ SP_GAME_EVENT executeCompterMove(SPGameWindow* gameWindow) {
 	SP_CHESS_GAME_MESSAGE returnedMessage = spChessGameSetMove(game, computerMove, false, true); // set the computer move
 	if (returnedMessage == SP_CHESS_GAME_SUCCESS) {
 		gameWindowDraw(gameWindow, true);
+		gameWindowPonder(gameWindow); // not started if the game is over
 
 		// If the computer has made a pawn promtion we prompts a relevant massagebox to the screen
 		if (computerMove->pawnPromotion) {
@@ -941,6 +1131,7 @@ void gameWindowDestroy(SPGameWindow* gameWindow) {
 	if (gameWindow == NULL)
 		return;
 
+	cancelComputerMove(gameWindow);
 	spArrayListDestroy(gameWindow->possibleMoves);
 	destroySettings(gameWindow->settings);
 
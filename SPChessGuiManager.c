@@ -4,6 +4,8 @@
  * This function is the main loop of the gui mode.
  * It does all that needed to starting/finishing the gui mode correctly,
  * and send the events to be handled when they accure.
+ * No event is handled for long: the computer's moves are searched on a thread of their own (see startComputerMove),
+ * so the loop keeps waiting for events while the computer is thinking.
  */
 void guiMainLoop() {
 	setvbuf(stdout,NULL,_IONBF,0);
@@ -16,6 +18,12 @@ void guiMainLoop() {
 		return;
 	}
 
+	if (!gameWindowRegisterEvents()) {
+		printf(SDL_INIT_ERROR, SDL_GetError());
+		SDL_Quit();
+		return;
+	}
+
 	SPGuiManager* manager = guiManagerCreate();
 	if (manager == NULL ) {
 		SDL_Quit();
@@ -133,7 +141,7 @@ SP_MANAGER_EVENT managerHandleEvent(SPGuiManager* manager, SDL_Event* event) {
 				SPGameWindow* gameWindow = manager->gameWindow;
 				if(gameWindow->settings->userColor == BLACK_PLAYER) {
 					gameWindow->gameIsSaved = false;
-					if (executeCompterMove(gameWindow) == SP_GAME_EVENT_QUIT) { // execute computer move
+					if (startComputerMove(gameWindow) == SP_GAME_EVENT_QUIT) { // start thinking on the computer move
 						gameWindowDestroy(manager->gameWindow);
 						manager->gameWindow = NULL;
 						return SP_MANAGER_QUIT;
@@ -237,7 +245,7 @@ SP_MANAGER_EVENT handleManagerDueToSettingsEvent(SPGuiManager* manager, SP_SETTI
 				return SP_MANAGER_QUIT;
 			}
 
-			settings->game = spChessGameCreate(HISTORY_SIZE);
+			settings->game = spChessGameCreate();
 			if (settings->game == NULL) {
 				printf(GAME_WINDOW_CREATION_ERROR);
 				destroySettings(settings);
@@ -308,6 +316,14 @@ SP_MANAGER_EVENT handleManagerDueToLoadEvent(SPGuiManager* manager, SP_LOAD_EVEN
 			if (manager->gameWindow != NULL) { // back to the Game window
 				SDL_ShowWindow(manager->gameWindow->window);
 				manager->activeWindow = SP_GAME_WINDOW_ACTIVE;
+
+				// the computer's thinking (or pondering) was cancelled when the Load window was opened, so it starts again
+				if (gameWindowComputerTurn(manager->gameWindow) && (startComputerMove(manager->gameWindow) == SP_GAME_EVENT_QUIT)) {
+					gameWindowDestroy(manager->gameWindow);
+					manager->gameWindow = NULL;
+					return SP_MANAGER_QUIT;
+				}
+				gameWindowPonder(manager->gameWindow);
 			}
 			else {                             // back to the Main window
 				SDL_ShowWindow(manager->mainWindow->window);
@@ -406,7 +422,7 @@ SP_MANAGER_EVENT handleManagerDueToGameEvent(SPGuiManager* manager, SP_GAME_EVEN
 			gameWindow = manager->gameWindow;
 			if (gameWindow->settings->userColor == BLACK_PLAYER) {
 				gameWindow->gameIsSaved = false;
-				if (executeCompterMove(gameWindow) == SP_GAME_EVENT_QUIT) { // execute the computer move as the first move
+				if (startComputerMove(gameWindow) == SP_GAME_EVENT_QUIT) { // start thinking on the computer move as the first move
 					gameWindowDestroy(manager->gameWindow);
 					manager->gameWindow = NULL;
 					return SP_MANAGER_QUIT;
@@ -432,6 +448,7 @@ SP_MANAGER_EVENT handleManagerDueToGameEvent(SPGuiManager* manager, SP_GAME_EVEN
 			return SP_GAME_EVENT_NONE;
 
 		case SP_GAME_EVENT_LOAD:
+			cancelComputerMove(manager->gameWindow); // the Game window doesn't get the events while the Load window is active
 			SDL_HideWindow(manager->gameWindow->window);
 			manager->loadWindow = loadWindowCreate();
 
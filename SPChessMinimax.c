@@ -1,25 +1,110 @@
 #include "SPChessMinimax.h"
 
+/**
+ * The state of the current search that is shared by all its threads: the deadline of its time budget (that only the main
+ * thread checks), and the flag that stops all the threads (when the time is over, when the main thread is done, when a
+ * memory error occurred or when the search is cancelled by spChessMinimaxStop). The flag is only accessed atomically
+ * (see searchIsStopped and setSearchStopped), because it is written and read by different threads. The clock is checked
+ * only once every TIME_CHECK_NODES_INTERVAL nodes, because reading it is much slower than searching a node.
+ */
+static long long searchDeadline = NO_DEADLINE;
+static bool      searchStopped  = false;
+
+/**
+ * The threads of the search (see SearchThread). They are kept between searches, so every thread keeps its move ordering heuristics.
+ */
+static SearchThread searchThreads[MAX_SEARCH_THREADS];
+
+/**
+ * The statistics of the last search (summed over all its threads).
+ */
+static SearchStatistics searchStatistics;
+
+/**
+ * The state of the search that ponders on the opponent's time (see spChessMinimaxPonderStart): its thread, the copy of the game
+ * that it searches (NULL when there is no pondering search), its depth and number of threads, and the flag that denotes that it
+ * is done.
+ */
+static pthread_t     ponderThread;
+static SPChessGame*  ponderGame         = NULL;
+static int           ponderDepth        = 0;
+static int           ponderNumOfThreads = DEFAULT_SEARCH_THREADS;
+static bool          ponderDone         = false;
+
+/**
+ * The function initiates the Minimax algorithm for choosing the best next Chess move for the current
+ * player according to a given Chess game board, searching the Minimax tree to the given depth without a time limit
+ * (by calling the function spChessMinimaxTimedMove).
+ *
+ * @param game         - The current Chess game
+ * @param maxDepth     - The difficulty level of the game and the maximum depth of the Minimax tree
+ * @param numOfThreads - The number of threads that search the Minimax tree
+ *
+ * @precondition - game is not over (i.e. game->status is not WHITE_PLAYER_WINS nor BLACK_PLAYER_WINS nor TIED_GAME)
+ *
+ * @return
+ * 		The move that is returned from the function spChessMinimaxTimedMove.
+ */
+Move* spChessMinimaxMove(SPChessGame* game, int maxDepth, int numOfThreads) {
+	return spChessMinimaxTimedMove(game, maxDepth, numOfThreads, NO_TIME_LIMIT);
+}
+
+/**
+ * The function chooses the best next Chess move for the current player according to a given Chess game board, within a given
+ * time budget (by calling the helper function searchBestMove). A search that ponders on the opponent's time is stopped first,
+ * because only one search can run at a time (its results are kept in the transposition table, see spChessMinimaxPonderStart).
+ *
+ * @param game         - The current Chess game
+ * @param maxDepth     - The maximum depth of the Minimax tree
+ * @param numOfThreads - The number of threads that search the Minimax tree (between 1 and MAX_SEARCH_THREADS)
+ * @param timeBudgetMs - The time budget of the search in milliseconds (NO_TIME_LIMIT, or any non-positive value, means no time limit)
+ *
+ * @precondition - game is not over (i.e. game->status is not WHITE_PLAYER_WINS nor BLACK_PLAYER_WINS nor TIED_GAME)
+ *
+ * @return
+ * 		The move that is returned from the helper function searchBestMove.
+ */
+Move* spChessMinimaxTimedMove(SPChessGame* game, int maxDepth, int numOfThreads, int timeBudgetMs) {
+	spChessMinimaxPonderStop();
+
+	return searchBestMove(game, maxDepth, numOfThreads, timeBudgetMs);
+}
+
 /**
  * The function initiates the Minimax algorithm for choosing the best next Chess move for the current
- * player according to a given Chess game board.
+ * player according to a given Chess game board, within a given time budget.
  * The Minimax algorithm will use a naive scoring function and the "Alpha-beta Pruning" technique.
- * The algorithm is initiated by calling to the helper function alphaBetaPruning.
- * The current game state is not changed by this alogrithm (a copy is created each time a new node is created),
- * as well as the history of previous moves (actually when the game is copied, the history is not, and that's
- * because the algorithm doesn't undo moves - so no need to copy the history).
+ * The algorithm is initiated by calling to the helper function alphaBetaPruning, using "iterative deepening": the Minimax tree is
+ * searched to depth 1, then to depth 2, and so on until maxDepth, and the move that is returned is the move that was chosen by
+ * the last iteration that was completed before the time budget was over. An iteration that is still running when the time is over
+ * is stopped (and its move is ignored), except the first one, so a move is always chosen.
+ * The deeper iterations are not much slower than searching their depth directly, because the results of the previous iterations
+ * are kept in the transposition table and their best moves are searched first.
+ * When more than one thread is used, the search is a "Lazy SMP" search: the helper threads run the same iterative deepening
+ * on the same position (every other helper thread one depth ahead), and the only thing they share with the main thread is the
+ * transposition table. The results that the helper threads store there make the search of the main thread faster, and the move
+ * that is returned is the move of the main thread. The helper threads are stopped once the main thread is done.
+ * The current game state is not changed by this alogrithm: the game is copied once for every thread, and the whole Minimax tree
+ * of a thread is searched on its single copy by making every move in place and unmaking it when its subtree is done.
+ * The search works with packed moves (see SPChessPackedMove) for its move lists, its killer moves and the transposition table,
+ * and only the move that is made at every depth is converted to a move of the game (see makeSearchMove). The chosen move is
+ * converted to a move of the game as well, for the console and the GUI.
+ * The history of previous moves is not changed as well (actually when the game is copied, the history is not, and that's
+ * because the moves of the algorithm are not saved in the history - so no need to copy it).
  *
- * @param game     - The current Chess game
- * @param maxDepth - The difficulty level of the game and the maximum depth of the Minimax tree
+ * @param game         - The current Chess game
+ * @param maxDepth     - The maximum depth of the Minimax tree
+ * @param numOfThreads - The number of threads that search the Minimax tree (between 1 and MAX_SEARCH_THREADS)
+ * @param timeBudgetMs - The time budget of the search in milliseconds (NO_TIME_LIMIT, or any non-positive value, means no time limit)
  *
  * @precondition - game is not over (i.e. game->status is not WHITE_PLAYER_WINS nor BLACK_PLAYER_WINS nor TIED_GAME)
  *
  * @return
  * 		NULL if either game is NULL or maxDepth <= 0 or an allocation memory occurred (denoted when the value that is returned
- * 		 from the helper function alphaBetaPruning equals INT_MIN).
+ * 		 from the helper function alphaBetaPruning equals INT_MIN, in any of the threads).
  * 		On success, returns the move that was chosen for the player by the Minimax algorithm.
  */
-Move* spChessMinimaxMove(SPChessGame* game, int maxDepth) {
+Move* searchBestMove(SPChessGame* game, int maxDepth, int numOfThreads, int timeBudgetMs) {
 	if ((game == NULL) || (maxDepth <= 0))
 		return NULL;
 
@@ -27,32 +112,521 @@ Move* spChessMinimaxMove(SPChessGame* game, int maxDepth) {
 	if (minimaxMove == NULL)
 		return NULL;
 
-	bool memoryOccured = (alphaBetaPruning(game, minimaxMove, ROOT_DEPTH, maxDepth, INT_MIN, INT_MAX, game->currentPlayer) == INT_MIN);
+	if (maxDepth > MAX_SEARCH_DEPTH)
+		maxDepth = MAX_SEARCH_DEPTH;
+
+	if (numOfThreads < 1)
+		numOfThreads = 1;
+	else if (numOfThreads > MAX_SEARCH_THREADS)
+		numOfThreads = MAX_SEARCH_THREADS;
+
+	for (int threadNum = 0; threadNum < numOfThreads; threadNum++) {
+		if (!initSearchThread(&(searchThreads[threadNum]), game, threadNum, maxDepth)) {
+			destroySearchThreads(threadNum);
+			free(minimaxMove);
+			return NULL;
+		}
+	}
+
+	spChessTTNewSearch();
+	searchDeadline = (timeBudgetMs > 0) ? (spTimerNowMs() + timeBudgetMs) : NO_DEADLINE;
+	setSearchStopped(false);
+
+	// a helper thread that couldn't be created just doesn't take part in the search
+	pthread_t helpers[MAX_SEARCH_THREADS];
+	int       numOfHelpers = 0;
 
-	// if memory occured we free the move that was created and nullify the pointer
+	while (   ((numOfHelpers + 1) < numOfThreads)
+		   && (pthread_create(&(helpers[numOfHelpers]), NULL, helperThreadSearch, &(searchThreads[numOfHelpers + 1])) == 0)) {
+
+				numOfHelpers++;
+	}
+
+	iterativeDeepening(&(searchThreads[MAIN_SEARCH_THREAD]));
+
+	setSearchStopped(true);
+	for (int helperNum = 0; helperNum < numOfHelpers; helperNum++)
+		pthread_join(helpers[helperNum], NULL);
+
+	bool memoryOccured = collectSearchResults(numOfHelpers + 1);
+
+	/**
+	 * a search that was stopped before its first iteration was completed (see spChessMinimaxStop) falls back to a legal move, that is
+	 * found on the main thread's copy of the game (back at the root position), because the given game is not changed by the search
+	 */
+	PackedMove bestMove = searchThreads[MAIN_SEARCH_THREAD].bestMove;
+	if (!memoryOccured && (bestMove == NULL_PACKED_MOVE))
+		bestMove = fallbackMove(searchThreads[MAIN_SEARCH_THREAD].game);
+
+	destroySearchThreads(numOfThreads);
+
+	/**
+	 * if memory occured we free the move that was created and nullify the pointer (the transposition table is emptied as well,
+	 * because the values that were returned from the interrupted subtrees are not real results)
+	 */
 	if (memoryOccured) {
+		spChessTTClear();
 		free(minimaxMove);
-		minimaxMove = NULL;
+		return NULL;
 	}
 
+	// the move is unpacked on the given game, that is at the position the search started from
+	spChessGameUnpackMove(game, bestMove, minimaxMove);
+
 	return minimaxMove;
 }
 
+/**
+ * The function stops the current search (if there is one), from another thread than the threads of the search: every thread
+ * notices it at its next node, unmakes the moves of its path on its way back to the root, and the search returns the move of its
+ * last completed iteration (even the first iteration is stopped, and then a fallback move is returned, see fallbackMove).
+ * A search that starts after the call is not stopped, so a caller that has to stop a search that may not have started yet should
+ * call the function again until the search returns.
+ */
+void spChessMinimaxStop(void) {
+	setSearchStopped(true);
+}
+
+/**
+ * The function checks if the current search is stopped. The flag is loaded atomically, because it is set by other threads.
+ *
+ * @return
+ * 		True  - If the search is stopped.
+ * 		False - Otherwise.
+ */
+bool searchIsStopped(void) {
+	return __atomic_load_n(&searchStopped, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * The function sets the flag that stops the current search. The flag is stored atomically, because it is read by other threads.
+ *
+ * @param stopped - The new value of the flag
+ */
+void setSearchStopped(bool stopped) {
+	__atomic_store_n(&searchStopped, stopped, __ATOMIC_RELEASE);
+}
+
+/**
+ * The function starts to ponder on the opponent's time: while the opponent (the user) is thinking on its move, a thread of
+ * its own searches the position after the opponent's predicted reply, to the depth of the computer's next search. The predicted
+ * reply is the best move that the last search stored in the transposition table for the given position (see storedBestMove).
+ * When the opponent plays the predicted reply (a "ponder hit"), the next search finds the results of the pondering search in the
+ * transposition table, so its iterations settle most of their nodes at once. When the opponent plays another move (a "ponder miss"),
+ * the pondering search is stopped and its move is ignored, and only its results that are shared with the actual position are used.
+ * Without a predicted reply, the given position itself is searched one depth deeper, so the positions after all the opponent's
+ * moves are searched to the depth of the next search.
+ * The pondering search runs on its own copy of the game, and it is stopped by spChessMinimaxPonderStop (or by the next search).
+ *
+ * @param game         - The current Chess game (the opponent's turn to play)
+ * @param maxDepth     - The maximum depth of the next search of the computer
+ * @param numOfThreads - The number of threads that search the Minimax tree
+ *
+ * @return
+ * 		False - If game is NULL, maxDepth <= 0, a pondering search is already running, the game is over after the predicted reply,
+ * 		        or a memory error occurred (the pondering search is not started).
+ * 		True  - Otherwise.
+ */
+bool spChessMinimaxPonderStart(SPChessGame* game, int maxDepth, int numOfThreads) {
+	if ((game == NULL) || (maxDepth <= 0) || (ponderGame != NULL))
+		return false;
+
+	ponderGame = spChessGameCopy(game);
+	if (ponderGame == NULL)
+		return false;
+
+	ponderDepth        = maxDepth;
+	ponderNumOfThreads = numOfThreads;
+
+	PackedMove reply = storedBestMove(ponderGame);
+	if (reply != NULL_PACKED_MOVE) {
+		Move       replyMove;
+		UndoRecord undo;
+
+		spChessGameUnpackMove(ponderGame, reply, &replyMove);
+		if (spChessGameMakeMove(ponderGame, &replyMove, &undo) != SP_CHESS_GAME_SUCCESS) {
+			spChessGameDestroy(ponderGame);
+			ponderGame = NULL;
+			return false;
+		}
+	}
+	else
+		ponderDepth++;
+
+	// the search is not started if the game is over after the predicted reply
+	LegalityMasks masks;
+	getLegalityMasks(ponderGame, &masks);
+	ponderGame->status = unfinishedGameStatus(&masks);
+
+	__atomic_store_n(&ponderDone, false, __ATOMIC_RELEASE);
+	if (!playerHasPossibleMove(ponderGame, &masks) || (pthread_create(&ponderThread, NULL, ponderThreadSearch, NULL) != 0)) {
+		spChessGameDestroy(ponderGame);
+		ponderGame = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * The function stops the search that ponders on the opponent's time (if there is one) and waits for its thread. The search is
+ * stopped again and again until it is done, because a stop that comes before the search has started would be missed.
+ */
+void spChessMinimaxPonderStop(void) {
+	if (ponderGame == NULL)
+		return;
+
+	while (!__atomic_load_n(&ponderDone, __ATOMIC_ACQUIRE)) {
+		spChessMinimaxStop();
+		sched_yield();
+	}
+
+	pthread_join(ponderThread, NULL);
+	spChessGameDestroy(ponderGame);
+	ponderGame = NULL;
+}
+
+/**
+ * The start routine of the thread that ponders on the opponent's time (see spChessMinimaxPonderStart).
+ *
+ * @param data - Not used
+ *
+ * @return
+ * 		NULL (the results of the pondering search are kept in the transposition table).
+ */
+void* ponderThreadSearch(void* data) {
+	(void) data;
+
+	free(searchBestMove(ponderGame, ponderDepth, ponderNumOfThreads, NO_TIME_LIMIT));
+	__atomic_store_n(&ponderDone, true, __ATOMIC_RELEASE);
+
+	return NULL;
+}
+
+/**
+ * The function returns the best move that is stored for the given position in the transposition table (after the computer's move,
+ * that is the move that the last search expected the opponent to play).
+ * The move is checked to be one of the legal moves of the position, because the entry may belong to another position whose key
+ * collides with the position's key. The game status is set by the check (the castling moves depend on it), so the function
+ * is only called on a copy of the game that belongs to the search.
+ *
+ * @param game - A copy of the current Chess game
+ *
+ * @return
+ * 		NULL_PACKED_MOVE - If there is no such legal move.
+ * 		Otherwise        - The stored best move.
+ */
+PackedMove storedBestMove(SPChessGame* game) {
+	TTEntry entry;
+	if (!spChessTTProbe(game->zobristKey, &entry) || (entry.bestMove == NULL_PACKED_MOVE))
+		return NULL_PACKED_MOVE;
+
+	PackedMove    moves[MAX_POSITION_MOVES];
+	LegalityMasks masks;
+	getLegalityMasks(game, &masks);
+	game->status = unfinishedGameStatus(&masks);
+
+	int numOfMoves = getPossiblePackedMoves(game, moves, &masks, false);
+	for (int moveNum = 0; moveNum < numOfMoves; moveNum++) {
+		if (moves[moveNum] == entry.bestMove)
+			return entry.bestMove;
+	}
+
+	return NULL_PACKED_MOVE;
+}
+
+/**
+ * The function chooses the move of a search that was stopped before any of its iterations was completed: the best move that is
+ * stored for the position in the transposition table (see storedBestMove), or else the first legal move of the position.
+ *
+ * @param game - A copy of the current Chess game (at the position the search started from)
+ *
+ * @return
+ * 		NULL_PACKED_MOVE - If the position has no legal moves.
+ * 		Otherwise        - The fallback move.
+ */
+PackedMove fallbackMove(SPChessGame* game) {
+	PackedMove move = storedBestMove(game);
+	if (move != NULL_PACKED_MOVE)
+		return move;
+
+	PackedMove    moves[MAX_POSITION_MOVES];
+	LegalityMasks masks;
+	getLegalityMasks(game, &masks);
+
+	return (getPossiblePackedMoves(game, moves, &masks, false) > 0) ? moves[0] : NULL_PACKED_MOVE;
+}
+
+/**
+ * The function prepares a thread for a new search: the thread gets its own copy of the game, its move ordering heuristics
+ * are aged (by calling the helper function ageOrderingHeuristics) and its statistics are reset.
+ *
+ * @param thread    - The thread to prepare
+ * @param game      - The current Chess game
+ * @param threadNum - The number of the thread (MAIN_SEARCH_THREAD for the main thread)
+ * @param maxDepth  - The maximum depth of the Minimax tree
+ *
+ * @return
+ * 		False - If a memory error occurred.
+ * 		True  - Otherwise.
+ */
+bool initSearchThread(SearchThread* thread, SPChessGame* game, int threadNum, int maxDepth) {
+	thread->game = spChessGameCopy(game);
+	if (thread->game == NULL)
+		return false;
+
+	thread->threadNum      = threadNum;
+	thread->maxDepth       = maxDepth;
+	thread->iterationDepth = 0;
+	thread->memoryOccured  = false;
+	thread->bestMove       = NULL_PACKED_MOVE; // a move of the previous search doesn't belong to the position
+
+	ageOrderingHeuristics(thread);
+	memset(&(thread->statistics), 0, sizeof(SearchStatistics));
+
+	return true;
+}
+
+/**
+ * The function frees the games of the given number of first threads (the threads themselves are kept for the next search).
+ *
+ * @param numOfThreads - The number of threads whose games should be freed
+ */
+void destroySearchThreads(int numOfThreads) {
+	for (int threadNum = 0; threadNum < numOfThreads; threadNum++) {
+		spChessGameDestroy(searchThreads[threadNum].game);
+		searchThreads[threadNum].game = NULL;
+	}
+}
+
+/**
+ * The function sums the statistics of the threads that took part in the search (the completed depth is the main thread's one).
+ *
+ * @param numOfThreads - The number of threads that took part in the search
+ *
+ * @return
+ * 		True  - If a memory error occurred in any of the threads.
+ * 		False - Otherwise.
+ */
+bool collectSearchResults(int numOfThreads) {
+	bool memoryOccured = false;
+
+	memset(&searchStatistics, 0, sizeof(SearchStatistics));
+
+	for (int threadNum = 0; threadNum < numOfThreads; threadNum++) {
+		SearchStatistics* statistics = &(searchThreads[threadNum].statistics);
+
+		searchStatistics.nodes            += statistics->nodes;
+		searchStatistics.quiescenceNodes  += statistics->quiescenceNodes;
+		searchStatistics.cutoffs          += statistics->cutoffs;
+		searchStatistics.firstMoveCutoffs += statistics->firstMoveCutoffs;
+		searchStatistics.ttCutoffs        += statistics->ttCutoffs;
+		searchStatistics.killerCutoffs    += statistics->killerCutoffs;
+		searchStatistics.historyCutoffs   += statistics->historyCutoffs;
+
+		memoryOccured = (memoryOccured || searchThreads[threadNum].memoryOccured);
+	}
+
+	searchStatistics.completedDepth = searchThreads[MAIN_SEARCH_THREAD].statistics.completedDepth;
+	searchStatistics.numOfThreads   = numOfThreads;
+
+	return memoryOccured;
+}
+
+/**
+ * The start routine of a helper thread of the search.
+ *
+ * @param thread - The helper thread (a SearchThread)
+ *
+ * @return
+ * 		NULL (the results of a helper thread are kept in its SearchThread).
+ */
+void* helperThreadSearch(void* thread) {
+	iterativeDeepening((SearchThread*) thread);
+
+	return NULL;
+}
+
+/**
+ * The function runs the iterative deepening of one thread of the search, by calling the helper function alphaBetaPruning for
+ * every depth until the thread's maximum depth. The main thread starts from depth 1, and so does every other helper thread,
+ * while the rest of the helper threads start from depth 2, so the threads don't all search the same depth at the same time.
+ * The move of the last completed iteration is kept as the thread's best move. A memory error in any thread stops the whole search.
+ *
+ * @param thread - A thread of the search
+ */
+void iterativeDeepening(SearchThread* thread) {
+	int firstDepth = 1 + (thread->threadNum % HELPER_DEPTH_STAGGER);
+
+	for (int depth = firstDepth; depth <= thread->maxDepth; depth++) {
+		// the first iteration of the main thread is never stopped, so a move is always chosen
+		thread->iterationDepth = depth;
+		if (searchIsStopped() || searchTimeIsUp(thread))
+			break;
+
+		PackedMove iterationMove = NULL_PACKED_MOVE;
+		thread->memoryOccured = (alphaBetaPruning(thread, &iterationMove, ROOT_DEPTH, depth, INT_MIN, INT_MAX, thread->game->currentPlayer) == INT_MIN);
+
+		if (thread->memoryOccured) {
+			setSearchStopped(true);
+			break;
+		}
+
+		if (searchIsStopped())
+			break;
+
+		thread->bestMove = iterationMove;
+		thread->statistics.completedDepth = depth;
+	}
+}
+
+/**
+ * The function counts a new node of the current search, and once every TIME_CHECK_NODES_INTERVAL nodes
+ * checks if the search should be stopped because its time budget is over.
+ *
+ * @param thread - The thread that searches the node
+ *
+ * @return
+ * 		True  - If the search is stopped.
+ * 		False - Otherwise.
+ */
+bool searchNodeStopped(SearchThread* thread) {
+	thread->statistics.nodes++;
+	if (((thread->statistics.nodes % TIME_CHECK_NODES_INTERVAL) == 0) && searchTimeIsUp(thread))
+		setSearchStopped(true);
+
+	return searchIsStopped();
+}
+
+/**
+ * The function checks if the deadline of the current search has passed. Only the main thread checks the clock (the helper threads
+ * are stopped by the main thread), and not during its first iteration.
+ *
+ * @param thread - A thread of the search
+ *
+ * @return
+ * 		True  - If the search has a deadline and it has passed.
+ * 		False - Otherwise.
+ */
+bool searchTimeIsUp(SearchThread* thread) {
+	if ((thread->threadNum != MAIN_SEARCH_THREAD) || (thread->iterationDepth <= 1))
+		return false;
+
+	return ((searchDeadline != NO_DEADLINE) && (spTimerNowMs() >= searchDeadline));
+}
+
+/**
+ * The function returns the statistics of the last search. Every node is counted in nodes (see searchNodeStopped), including
+ * the nodes of the quiescence search, that are also counted on their own in quiescenceNodes.
+ *
+ * @param statistics - The statistics structure to be filled
+ */
+void spChessMinimaxGetStatistics(SearchStatistics* statistics) {
+	if (statistics != NULL)
+		*statistics = searchStatistics;
+}
+
+/**
+ * The function ages the move ordering heuristics between searches: the killer moves are cleared (the depths of the
+ * next search belong to other positions), and the history scores are halved, so the cutoffs of the previous searches
+ * still count but the cutoffs of the next search soon count more.
+ *
+ * @param thread - A thread of the search
+ */
+void ageOrderingHeuristics(SearchThread* thread) {
+	for (int depth = 0; depth < MAX_SEARCH_DEPTH; depth++)
+		for (int slot = 0; slot < NUM_OF_KILLER_MOVES; slot++)
+			thread->killerMoves[depth][slot] = NULL_PACKED_MOVE; // an empty slot never matches a move
+
+	halveHistoryScores(thread);
+}
+
+/**
+ * The function halves all the history scores. It is called when the history scores are aged, and when one of them
+ * reaches HISTORY_MAX_SCORE (so the history scores never reach the order scores of the killer moves).
+ *
+ * @param thread - A thread of the search
+ */
+void halveHistoryScores(SearchThread* thread) {
+	for (int player = 0; player < NUM_OF_PLAYERS; player++)
+		for (int type = 0; type < NUM_OF_PIECE_TYPES; type++)
+			for (int square = 0; square < NUM_OF_SQUARES; square++)
+				thread->historyScores[player][type][square] /= 2;
+}
+
+/**
+ * The function updates the move ordering heuristics after a quiet move caused a cutoff in a node: the move becomes the
+ * first killer move of the node's depth (the previous first killer move becomes the second one), and the history score
+ * of its piece and destination position is increased by the square of the remaining depth (a cutoff closer to the root
+ * saves a bigger subtree). Castle moves are kept as killer moves, but they don't have a history score.
+ *
+ * @param thread    - The thread that searches the node (its game is at the node's position)
+ * @param move      - The quiet move that caused the cutoff
+ * @param currDepth - The current depth of the Minimax tree
+ * @param depth     - The remaining depth of the search from the node
+ */
+void updateOrderingHeuristics(SearchThread* thread, PackedMove move, int currDepth, int depth) {
+	PackedMove* killers = thread->killerMoves[currDepth];
+
+	if (move != killers[0]) {
+		killers[1] = killers[0];
+		killers[0] = move;
+	}
+
+	if (spPackedMoveIsCastle(move))
+		return;
+
+	int* historyScore = &(thread->historyScores[(int) thread->game->currentPlayer][movingPieceType(thread->game, move)][spPackedMoveDst(move)]);
+
+	// a deep bonus may be bigger than HISTORY_MAX_SCORE itself, so the scores are halved until they are all below it again
+	*historyScore += (depth * depth);
+	while (*historyScore >= HISTORY_MAX_SCORE)
+		halveHistoryScores(thread);
+}
+
+/**
+ * The function updates the statistics of the search after a cutoff in a node that is not a leaf, according to the
+ * searched move that caused it: its place in the node's move order and the ordering heuristic that chose it.
+ *
+ * @param statistics - The statistics of the thread that searches the node
+ * @param moveNum    - The place of the move in the node's move order
+ * @param moveScore  - The order score of the move (see moveOrderScore)
+ */
+void updateCutoffStatistics(SearchStatistics* statistics, int moveNum, int moveScore) {
+	statistics->cutoffs++;
+
+	if (moveNum == 0)
+		statistics->firstMoveCutoffs++;
+
+	if ((moveScore == FIRST_KILLER_ORDER_SCORE) || (moveScore == SECOND_KILLER_ORDER_SCORE))
+		statistics->killerCutoffs++;
+	else if ((moveScore > QUIET_MOVE_ORDER_SCORE) && (moveScore < SECOND_KILLER_ORDER_SCORE))
+		statistics->historyCutoffs++;
+}
+
 /**
  * The function runs the MiniMax algorithm (using "Alpha-beta Pruning" technique), by building recursively and dynamically the Minimax
  * tree for reaching the best move to pick according the root node's game board for the player which is it's turn to play.
- * To create the relevant nodes, the function scans the game board bottom-up as main scan and left-to-right as secondary scan.
- * For each relevant piece (that belongs to the current player to play) the fuction creates all of it's possible moves
- * by calling the helper function getPossiblePieceMoves that sets these move in a given array list (the sorting is bottom-up
- * as main sort and left-to-right as secondary sort).
+ * To create the relevant nodes, the function creates all the possible moves of the current player to play by calling the helper
+ * function getPossiblePackedMoves, and searches them by the move ordering of the helper functions scoreMoves and pickNextMove
+ * (the moves that are most likely to cause a cutoff are searched first, because that's what makes the pruning effective).
+ * Every move is made in place on the given game (by calling the helper function makeSearchMove) before going down to its subtree,
+ * and unmade (by calling the helper function unmakeSearchMove) when the subtree returns, so the game is the same when the function returns.
+ * The result of every node that is not a leaf is stored in the transposition table (see SPChessTranspositionTable), keyed by the
+ * Zobrist key of its position. When a node's position is found in the table, the node returns the stored score without being
+ * searched if the stored result is deep enough and its bound settles the node, and otherwise the stored best move is ordered first.
  * The "Alpha-beta Pruning" technique allows the algorithm avoid building nodes that can be seen as irrelevant and thus save time and memory.
  * The alpha and beta values might be updated at each depth of the recursion, while the move that will be returned as the best move to
  * choose is updated only at depth 0 (i.e. the root's depth).
  * The recursion ends when the Minimax tree gets to a leaf, which happens when either:
- * 1) The board represents a game that was over.
- * 2) The recursion reached its maximum depth according to the difficulty of the game.
+ * 1) The board represents a game that was over (the node has no legal moves, because the game status is not calculated when a
+ *     move is made during the search).
+ * 2) The recursion reached its maximum depth according to the difficulty of the game (then the node's value is
+ *     calculated by the quiescence search, by calling the helper function quiescenceSearch).
+ * When the time budget of the search is over, the search is stopped: every node returns immediately without storing its result
+ * (the values that are returned from a stopped search are meaningless, and the caller ignores them).
  *
- * @param currentGame      - The current Chess game node
+ * @param thread           - The thread that searches the node (its game is the single game that its whole tree is searched on)
  * @param minimaxMove      - The move to be updated as the move that the original player that is maximing should select
  * @param currDepth        - The current depth of the Minimax tree
  * @param maxDepth         - The difficulty level of the game and the maximum depth for the Minimax tree
@@ -61,85 +635,545 @@ Move* spChessMinimaxMove(SPChessGame* game, int maxDepth) {
  * @param maximizingPlayer - The player which is its turn to play according to the root node of the tree
  *
  * @return
- * 		When a memory error occurs:
- * 		 1) If the current depth of the tree is greater than 0, INT_MAX is returned in case of a maxmizing node
- * 		     and INT_MIN is returned in case of a minimizing node.
+ * 		When a move couldn't be made (see searchErrorResult):
+ * 		 1) If the current depth of the tree is greater than 0, INT_MIN is returned in case of a maxmizing node
+ * 		     and INT_MAX is returned in case of a minimizing node.
  * 		 2) If the current depth of the tree is 0 (the root's depth), INT_MIN is returned.
  *
  * 		On success:
- * 		 1) If the recursion reached a leaf node, returns the scoring function value.
+ * 		 1) If the recursion reached a leaf node, returns the value of the finished game or the quiescence search value.
  * 		 2) If the current depth of the tree is greater than 0 but the node is not a leaf node:
  * 		     the alpha value is returned in case of a maxmizing node, and the beta value is returned
  * 		     in case of a minimizing node.
  * 		 3) If the recursion got back to the root node, INT_MAX is returned (denotes for the chessMinimaxMove
  * 		     that a move was chosen successfully).
  */
-int alphaBetaPruning(SPChessGame* currentGame, Move* minimaxMove, int currDepth, int maxDepth, int alpha, int beta, int maximizingPlayer) {
-	if (currDepth > ROOT_DEPTH) {
-		char currStatus = currentGame->status;
-		if ((currStatus == WHITE_PLAYER_WINS)  || (currStatus == BLACK_PLAYER_WINS) || (currStatus == TIED_GAME) || (currDepth == maxDepth))
-			return leafNodeResult(currentGame, maximizingPlayer);
-	}
+int alphaBetaPruning(SearchThread* thread, PackedMove* minimaxMove, int currDepth, int maxDepth, int alpha, int beta, int maximizingPlayer) {
+	if (searchNodeStopped(thread))
+		return TIE_SCORE;
 
-	bool choseMove = false; // denotes if so far at least one move was chosen as the move to be picked by the Minimax algorithm
-	bool maximize = ((currDepth % 2) == 0);
+	SPChessGame* currentGame = thread->game;
 
-	SPArrayList* pieceMoves = spArrayListCreate(MAX_MOVES_FOR_PIECE);
-	if (pieceMoves == NULL)
-		return freeMemory(pieceMoves, currDepth, maximize);
+	// at the maximum depth, the captures and promotions are searched until the position is quiet
+	if ((currDepth > ROOT_DEPTH) && (currDepth == maxDepth))
+		return quiescenceSearch(thread, currDepth, alpha, beta, maximizingPlayer);
 
-	int moveNum, numOfMoves, subtreeValue;
+	bool choseMove = false; // denotes if so far at least one move was chosen as the best move of the node
+	bool maximize  = ((currDepth % 2) == 0);
+	int  depth     = maxDepth - currDepth; // the remaining depth of the search from the node
+	int  origAlpha = alpha;
+	int  origBeta  = beta;
+
+	// a previous result of the node's position settles the node if it was searched deep enough and its score is out of the bounds
+	TTEntry entry;
+	bool    hasEntry = spChessTTProbe(currentGame->zobristKey, &entry);
+
+	if (hasEntry && (currDepth > ROOT_DEPTH) && (entry.depth >= depth)) {
+		int      score = switchScoreView(entry.score, maximize);
+		TT_BOUND bound = switchBoundView((TT_BOUND) entry.bound, maximize);
+
+		if (   (bound == TT_EXACT_SCORE)
+			|| ((bound == TT_LOWER_BOUND) && (score >= beta))
+			|| ((bound == TT_UPPER_BOUND) && (score <= alpha))) {
+
+					thread->statistics.ttCutoffs++;
+					return score;
+		}
+	}
 
-	for (int row = 0; ((alpha < beta) && (row < BOARD_LENGTH)); row++) {
-		for (int col = 0; ((alpha < beta) && (col < BOARD_LENGTH)); col++) {
-			char pieceType = currentGame->board[row][col];
-			if (!currentPlayerPiece(currentGame->currentPlayer, pieceType))
-				continue;
+	// the moves of the node are kept in the thread's ply of the node's depth, so no memory is allocated for them
+	SearchPly*  ply        = &(thread->plies[currDepth]);
+	PackedMove* nodeMoves  = ply->moves;
+	int*        moveScores = ply->moveScores;
+	PackedMove  bestMove   = NULL_PACKED_MOVE;
 
-			if (getPossiblePieceMoves(currentGame, pieceMoves, row, col, pieceType, true, true) != SP_CHESS_GAME_SUCCESS)
-				return freeMemory(pieceMoves, currDepth, maximize);
+	/**
+	 * the legality masks are calculated once for all the moves of the node (the node's game is the same after every unmade move),
+	 * and they also set the node's game status, that is not calculated when a move is made (a castle is not legal under "check")
+	 */
+	LegalityMasks masks;
+	getLegalityMasks(currentGame, &masks);
+	currentGame->status = unfinishedGameStatus(&masks);
 
-			numOfMoves = spArrayListSize(pieceMoves);
+	// a node without legal moves is a finished game ("checkmate" or "stalemate")
+	int numOfMoves = getPossiblePackedMoves(currentGame, nodeMoves, &masks, false);
+	if ((numOfMoves == 0) && (currDepth > ROOT_DEPTH)) {
+		currentGame->status = finishedGameStatus(currentGame, (currentGame->status == GAME_NOT_FINISHED_CHECK));
+		return leafNodeResult(currentGame, maximizingPlayer);
+	}
 
-			moveNum = 0;
-			while ((alpha < beta) && (moveNum < numOfMoves)) {
-				SPChessGame* descendantGame = spChessGameCopy(currentGame);
-				Move* currMove = spArrayListGetAt(pieceMoves, moveNum);
+	// the best move of the previous result (if there is one) is searched first
+	scoreMoves(thread, nodeMoves, numOfMoves, moveScores, ((hasEntry) ? entry.bestMove : NULL_PACKED_MOVE), thread->killerMoves[currDepth]);
 
-				if (   (descendantGame == NULL)
-					|| (currMove == NULL)
-					|| (spChessGameSetMove(descendantGame, currMove, true, true) != SP_CHESS_GAME_SUCCESS)) {
+	for (int moveNum = 0; ((alpha < beta) && !searchIsStopped() && (moveNum < numOfMoves)); moveNum++) {
+		pickNextMove(nodeMoves, moveScores, numOfMoves, moveNum);
 
-							spChessGameDestroy(descendantGame);
-							return freeMemory(pieceMoves, currDepth, maximize);
-				}
+		PackedMove currMove = nodeMoves[moveNum];
 
-				// the recursive call
-				subtreeValue = alphaBetaPruning(descendantGame, minimaxMove, currDepth + 1, maxDepth, alpha, beta, maximizingPlayer);
+		if (!searchMove(thread, currMove, minimaxMove, currDepth, maxDepth, &alpha, &beta, maximizingPlayer, &choseMove, &bestMove))
+			return searchErrorResult(currDepth, maximize);
 
-				// calls the function that is in charge of updating the alpha/beta values
-				updateBoundsAndMove(currMove, minimaxMove, &(alpha), &(beta), maximize, subtreeValue, currDepth, &(choseMove));
+		// a cutoff by a quiet move updates the ordering heuristics of the quiet moves
+		if ((alpha >= beta) && !searchIsStopped()) {
+			updateCutoffStatistics(&(thread->statistics), moveNum, moveScores[moveNum]);
 
-				spChessGameDestroy(descendantGame);
-				moveNum++;
-			}
-			spArrayListClear(pieceMoves);
+			if (!moveIsCapture(currentGame, currMove) && (spPackedMovePromotion(currMove) == PAWN_TYPE))
+				updateOrderingHeuristics(thread, currMove, currDepth, depth);
 		}
 	}
-	spArrayListDestroy(pieceMoves);
+
+	// the result of a stopped node is not complete
+	if (searchIsStopped())
+		return TIE_SCORE;
+
+	// storing the node's result (the score and its bound are switched to the point of view of the player that is its turn to play)
+	int nodeValue = (maximize) ? alpha : beta;
+	spChessTTStore(currentGame->zobristKey, depth, switchBoundView(nodeResultBound(alpha, beta, origAlpha, origBeta, maximize), maximize),
+				   switchScoreView(nodeValue, maximize), bestMove);
 
 	if (currDepth == ROOT_DEPTH)
 		return INT_MAX;
 
+	return nodeValue;
+}
+
+/**
+ * The function runs the quiescence search from a node at the maximum depth of the Minimax tree. Evaluating such a node by the
+ * scoring function alone is misleading in the middle of an exchange of pieces (e.g. right after a piece captured a protected piece),
+ * so only the captures and the pawn promotions of the node are searched (generated by the helper function getPossiblePackedMoves),
+ * recursively, until the position is quiet. The captures are searched by the "MVV-LVA" order (see scoreMoves), without which
+ * the pruning of long exchanges is poor. The search uses "Alpha-beta Pruning" as well, and two more prunings:
+ * 1) "Stand pat" - the player that is its turn to play is not forced to capture, so the scoring function value of the node bounds
+ *     its value, and a node whose scoring function value is already out of the bounds returns immediately.
+ * 2) "Delta pruning" - a move is skipped if even the whole material it wins (the captured piece and the promotion) together with a
+ *     safety margin (QUIESCENCE_DELTA_MARGIN, that covers the change of the piece-square scores) can't bring the scoring function value
+ *     of the node into the bounds.
+ * A player in "check" can't stand pat, because it has to get out of the check (and its scoring function value says nothing about
+ * a mate threat), so all the legal moves of the node are searched instead, without any of the prunings above.
+ * The results of the quiescence search are not stored in the transposition table.
+ *
+ * @param thread           - The thread that searches the node (its game is at the node's position)
+ * @param currDepth        - The current depth of the Minimax tree (the maximum depth of the tree, or deeper)
+ * @param alpha            - The maximum lower bound of possible scoring function values seen that is received from the node's parent
+ * @param beta             - The minimum upper bound of possible scoring function values seen that is received from the node's parent
+ * @param maximizingPlayer - The player which is its turn to play according to the root node of the tree
+ *
+ * @return
+ * 		When a move couldn't be made, INT_MIN is returned in case of a maxmizing node and INT_MAX is returned in case of a minimizing node.
+ * 		If the game is over, returns the value of the finished game.
+ * 		If the node returns by "stand pat" (or the thread has no more plies), returns the scoring function value.
+ * 		Otherwise, the alpha value is returned in case of a maxmizing node, and the beta value is returned in case of a minimizing node.
+ */
+int quiescenceSearch(SearchThread* thread, int currDepth, int alpha, int beta, int maximizingPlayer) {
+	if (searchNodeStopped(thread))
+		return TIE_SCORE;
+
+	thread->statistics.quiescenceNodes++;
+
+	SPChessGame* currentGame = thread->game;
+
+	/**
+	 * the node's game status is set here, because it is not calculated when a move is made (only the captures are generated,
+	 * so whether the game is over is checked without generating the rest of the moves)
+	 */
+	LegalityMasks masks;
+	getLegalityMasks(currentGame, &masks);
+	currentGame->status = unfinishedGameStatus(&masks);
+
+	if (!playerHasPossibleMove(currentGame, &masks)) {
+		currentGame->status = finishedGameStatus(currentGame, (currentGame->status == GAME_NOT_FINISHED_CHECK));
+		return leafNodeResult(currentGame, maximizingPlayer);
+	}
+
+	bool maximize = ((currDepth % 2) == 0);
+	bool inCheck  = (currentGame->status == GAME_NOT_FINISHED_CHECK);
+	int  standPat = scoringFunction(currentGame, maximizingPlayer);
+
+	// the plies of the thread are used up (only a long series of checks and evasions gets that deep), so the node is not searched
+	if (currDepth >= (MAX_SEARCH_PLIES - 1))
+		return standPat;
+
+	if (maximize && !inCheck) {
+		if (standPat >= beta)
+			return standPat;
+
+		if (standPat > alpha)
+			alpha = standPat;
+	}
+	else if (!inCheck) {
+		if (standPat <= alpha)
+			return standPat;
+
+		if (standPat < beta)
+			beta = standPat;
+	}
+
+	/**
+	 * the captures and promotions of the node (or all its evasions, in "check") are generated into the thread's ply of the node's depth,
+	 * so they can be searched in order
+	 */
+	SearchPly*  ply        = &(thread->plies[currDepth]);
+	PackedMove* nodeMoves  = ply->moves;
+	int*        moveScores = ply->moveScores;
+
+	int numOfMoves = getPossiblePackedMoves(currentGame, nodeMoves, &masks, !inCheck);
+	scoreMoves(thread, nodeMoves, numOfMoves, moveScores, NULL_PACKED_MOVE, NULL);
+
+	for (int moveNum = 0; ((alpha < beta) && !searchIsStopped() && (moveNum < numOfMoves)); moveNum++) {
+		pickNextMove(nodeMoves, moveScores, numOfMoves, moveNum);
+
+		PackedMove currMove = nodeMoves[moveNum];
+
+		// delta pruning (an evasion is never pruned)
+		int maxGain = moveMaterialGain(currentGame, currMove) + QUIESCENCE_DELTA_MARGIN;
+		if (!inCheck && ((maximize && ((standPat + maxGain) <= alpha)) || (!maximize && ((standPat - maxGain) >= beta))))
+			continue;
+
+		if (!makeSearchMove(thread, currDepth, currMove))
+			return searchErrorResult(currDepth, maximize);
+
+		int subtreeValue = quiescenceSearch(thread, currDepth + 1, alpha, beta, maximizingPlayer);
+
+		unmakeSearchMove(thread, currDepth);
+
+		if (maximize && (subtreeValue > alpha))
+			alpha = subtreeValue;
+		else if (!maximize && (subtreeValue < beta))
+			beta = subtreeValue;
+	}
+
 	return ((maximize) ? alpha : beta);
 }
 
+/**
+ * The function calculates the order score of every move in the given array (by calling the helper function moveOrderScore),
+ * so the moves can be searched by their order without sorting the array (see pickNextMove).
+ *
+ * @param thread     - The thread that searches the position (its game is at the position)
+ * @param moves      - The possible moves of the current position
+ * @param numOfMoves - The number of moves in the array
+ * @param scores     - The array to be filled with the order scores of the moves (in the same places as in the moves array)
+ * @param ttMove     - The best move of the position's transposition table entry (NULL_PACKED_MOVE if there is no such move)
+ * @param killers    - The killer moves of the node's depth (NULL for the quiescence search, that has no quiet moves)
+ */
+void scoreMoves(SearchThread* thread, PackedMove moves[], int numOfMoves, int scores[], PackedMove ttMove, PackedMove killers[]) {
+	for (int i = 0; i < numOfMoves; i++)
+		scores[i] = moveOrderScore(thread, moves[i], ttMove, killers);
+}
+
+/**
+ * The function calculates the order score of a move. The moves are ordered by:
+ * 1) The best move of the position's transposition table entry.
+ * 2) Captures, by the "MVV-LVA" order (see captureOrderScore).
+ * 3) Pawn promotions (that are not captures), by the value of the piece the pawn is promoted to.
+ * 4) The killer moves of the node's depth (first the newer one).
+ * 5) All the other ("quiet") moves, by the history score of their piece and destination position.
+ *
+ * @param thread  - The thread that searches the position (its game is at the position)
+ * @param move    - A possible move of the current position
+ * @param ttMove  - The best move of the position's transposition table entry (NULL_PACKED_MOVE if there is no such move)
+ * @param killers - The killer moves of the node's depth (NULL if there are no killer moves)
+ *
+ * @return
+ * 		The order score of the move (a higher score is searched first).
+ */
+int moveOrderScore(SearchThread* thread, PackedMove move, PackedMove ttMove, PackedMove killers[]) {
+	SPChessGame* game = thread->game;
+
+	if (move == ttMove)
+		return TT_MOVE_ORDER_SCORE;
+
+	if (moveIsCapture(game, move))
+		return (CAPTURE_ORDER_SCORE + captureOrderScore(game, move));
+
+	if (spPackedMovePromotion(move) != PAWN_TYPE)
+		return (PROMOTION_ORDER_SCORE + captureOrderScore(game, move));
+
+	if (killers != NULL) {
+		if (move == killers[0])
+			return FIRST_KILLER_ORDER_SCORE;
+
+		if (move == killers[1])
+			return SECOND_KILLER_ORDER_SCORE;
+	}
+
+	if (spPackedMoveIsCastle(move))
+		return QUIET_MOVE_ORDER_SCORE;
+
+	return (QUIET_MOVE_ORDER_SCORE + thread->historyScores[(int) game->currentPlayer][movingPieceType(game, move)][spPackedMoveDst(move)]);
+}
+
+/**
+ * The function moves the move that should be searched next to the given place in the array, choosing it from the moves that
+ * were not searched yet (the ones from the given place to the end of the array) by their order scores, that are moved along with them.
+ * Choosing the next move only when it is needed is cheaper than sorting the whole array, because most nodes are cut off after
+ * searching a few of their moves.
+ *
+ * @param moves      - The possible moves of the current position
+ * @param scores     - The order scores of the moves (filled by scoreMoves)
+ * @param numOfMoves - The number of moves in the array
+ * @param moveNum    - The place in the array of the move that should be searched next
+ */
+void pickNextMove(PackedMove moves[], int scores[], int numOfMoves, int moveNum) {
+	int bestNum = moveNum;
+
+	for (int i = moveNum + 1; i < numOfMoves; i++)
+		if (scores[i] > scores[bestNum])
+			bestNum = i;
+
+	if (bestNum == moveNum)
+		return;
+
+	PackedMove tempMove = moves[moveNum];
+	moves[moveNum]      = moves[bestNum];
+	moves[bestNum]      = tempMove;
+
+	int tempScore   = scores[moveNum];
+	scores[moveNum] = scores[bestNum];
+	scores[bestNum] = tempScore;
+}
+
+/**
+ * The function calculates the "MVV-LVA" order score of a capture (or a pawn promotion): the material it wins, weighted so
+ * that it always decides the order ("Most Valuable Victim" first), minus the value of the moving piece ("Least Valuable Attacker" first).
+ * A capture that wins much material is likely to cause a cutoff, and a capture by a cheap piece is likely to keep that material.
+ *
+ * @param game - A Chess game
+ * @param move - A capture (or a pawn promotion) of the current position
+ *
+ * @return
+ * 		The order score of the move (a higher score is searched first).
+ */
+int captureOrderScore(SPChessGame* game, PackedMove move) {
+	return ((moveMaterialGain(game, move) * MVV_LVA_VICTIM_WEIGHT) - pieceScore(movingPieceType(game, move)));
+}
+
+/**
+ * The function calculates the material that a move wins: the value of the piece it captures (if any), and
+ * for a pawn promotion move - the value that is added by replacing the pawn with the piece it is promoted to.
+ *
+ * @param game - A Chess game
+ * @param move - A move of the current position
+ *
+ * @return
+ * 		The material the move wins (by the values of pieceScore).
+ */
+int moveMaterialGain(SPChessGame* game, PackedMove move) {
+	int        dstSquare     = spPackedMoveDst(move);
+	PIECE_TYPE promotionType = spPackedMovePromotion(move);
+	int        gain          = (moveIsCapture(game, move)) ? pieceScore(getPieceType(game->board[SQUARE_ROW(dstSquare)][SQUARE_COL(dstSquare)])) : 0;
+
+	if (promotionType != PAWN_TYPE)
+		gain += (pieceScore(promotionType) - PAWN_SCORE);
+
+	return gain;
+}
+
+/**
+ * The function checks if a move captures a piece of the rival (a castle move never does).
+ *
+ * @param game - A Chess game
+ * @param move - A move of the current position
+ *
+ * @return
+ * 		True  - If the destination position of the move is occupied.
+ * 		False - Otherwise.
+ */
+bool moveIsCapture(SPChessGame* game, PackedMove move) {
+	return (!spPackedMoveIsCastle(move) && ((game->allPieces & SQUARE_BITBOARD(spPackedMoveDst(move))) != EMPTY_BITBOARD));
+}
+
+/**
+ * The function returns the type of the piece that a move moves (a pawn, for a pawn promotion move).
+ *
+ * @param game - A Chess game
+ * @param move - A move of the current position
+ *
+ * @return
+ * 		The type of the piece at the source position of the move.
+ */
+PIECE_TYPE movingPieceType(SPChessGame* game, PackedMove move) {
+	int srcSquare = spPackedMoveSrc(move);
+
+	return getPieceType(game->board[SQUARE_ROW(srcSquare)][SQUARE_COL(srcSquare)]);
+}
+
+/**
+ * The function returns the value of a type of piece, by its midgame material in the scoring function
+ * (the king has no value, because both players always have their king).
+ *
+ * @param type - The type of a Chess piece
+ *
+ * @return
+ * 		The value of the type of piece (0 for a king or NUM_OF_PIECE_TYPES).
+ */
+int pieceScore(PIECE_TYPE type) {
+	switch (type) {
+		case PAWN_TYPE:
+			return PAWN_SCORE;
+		case KNIGHT_TYPE:
+			return KNIGHT_SCORE;
+		case BISHOP_TYPE:
+			return BISHOP_SCORE;
+		case ROOK_TYPE:
+			return ROOK_SCORE;
+		case QUEEN_TYPE:
+			return QUEEN_SCORE;
+		default:
+			return 0;
+	}
+}
+
+/**
+ * The function searches the subtree of one move of a node of the Minimax tree: the move is made in place on the node's game
+ * (by calling the helper function makeSearchMove), the subtree is searched by a recursive call to alphaBetaPruning, and the move
+ * is unmade. Then, the node's bounds (and the Minimax move, at the root) are updated by calling the helper function updateBoundsAndMove.
+ *
+ * @param thread           - The thread that searches the node (its game is at the node's position)
+ * @param currMove         - The move to search
+ * @param minimaxMove      - The move to be updated as the move that the original player that is maximing should select
+ * @param currDepth        - The current depth of the Minimax tree
+ * @param maxDepth         - The difficulty level of the game and the maximum depth for the Minimax tree
+ * @param alpha            - The pointer to the current alpha value of the node
+ * @param beta             - The pointer to the current beta value of the node
+ * @param maximizingPlayer - The player which is its turn to play according to the root node of the tree
+ * @param choseMove        - The pointer to the indicator that denotes if so far at least one move was chosen as the best move of the node
+ * @param bestMove         - The best move of the node so far, updated if the move improves the node's bound
+ *
+ * @return
+ * 		False - If the move couldn't be made.
+ * 		True  - Otherwise.
+ */
+bool searchMove(SearchThread* thread, PackedMove currMove, PackedMove* minimaxMove, int currDepth, int maxDepth, int* alpha, int* beta, int maximizingPlayer, bool* choseMove, PackedMove* bestMove) {
+	if (!makeSearchMove(thread, currDepth, currMove))
+		return false;
+
+	// the recursive call
+	int subtreeValue = alphaBetaPruning(thread, minimaxMove, currDepth + 1, maxDepth, *alpha, *beta, maximizingPlayer);
+
+	unmakeSearchMove(thread, currDepth);
+
+	// the value of a stopped subtree is meaningless
+	if (searchIsStopped())
+		return true;
+
+	// calls the function that is in charge of updating the alpha/beta values
+	if (updateBoundsAndMove(currMove, minimaxMove, alpha, beta, ((currDepth % 2) == 0), subtreeValue, currDepth, choseMove))
+		*bestMove = currMove;
+
+	return true;
+}
+
+/**
+ * The function makes a move of a node in place on the game of the searching thread, by converting it to a move of the game
+ * (see spChessGameUnpackMove) and calling spChessGameMakeMove. The move and its undo record are kept in the thread's ply of the
+ * node's depth (see SearchPly), so no memory is allocated and the subtree of the move (that uses the deeper plies) doesn't change them.
+ *
+ * @param thread    - The thread that searches the node (its game is at the node's position)
+ * @param currDepth - The current depth of the Minimax tree
+ * @param move      - A legal move of the node
+ *
+ * @return
+ * 		False - If the move couldn't be made.
+ * 		True  - Otherwise.
+ */
+bool makeSearchMove(SearchThread* thread, int currDepth, PackedMove move) {
+	SearchPly* ply = &(thread->plies[currDepth]);
+
+	spChessGameUnpackMove(thread->game, move, &(ply->move));
+
+	return (spChessGameMakeMove(thread->game, &(ply->move), &(ply->undo)) == SP_CHESS_GAME_SUCCESS);
+}
+
+/**
+ * The function unmakes the move that was made by makeSearchMove at the given depth.
+ *
+ * @param thread    - The thread that searches the node
+ * @param currDepth - The current depth of the Minimax tree (of the node whose move is unmade)
+ */
+void unmakeSearchMove(SearchThread* thread, int currDepth) {
+	SearchPly* ply = &(thread->plies[currDepth]);
+
+	spChessGameUnmakeMove(thread->game, &(ply->move), &(ply->undo));
+}
+
+/**
+ * The function returns the bound type of a node's result, according to the node's bounds before and after its moves were searched.
+ * A maximizing node that reached its beta value (a cutoff) has a lower bound, and if no move improved its alpha value it has an
+ * upper bound. A minimizing node that reached its alpha value has an upper bound, and if no move improved its beta value it has
+ * a lower bound. Otherwise, the result of the node is exact.
+ *
+ * @param alpha     - The alpha value of the node after its moves were searched
+ * @param beta      - The beta value of the node after its moves were searched
+ * @param origAlpha - The alpha value that the node received from its parent
+ * @param origBeta  - The beta value that the node received from its parent
+ * @param maximize  - Indicates if the the node is a maximizing node or a minimizing node
+ *
+ * @return
+ * 		The bound type of the node's result (from the point of view of the maximizing player).
+ */
+TT_BOUND nodeResultBound(int alpha, int beta, int origAlpha, int origBeta, bool maximize) {
+	if (maximize) {
+		if (alpha >= beta)
+			return TT_LOWER_BOUND;
+
+		return ((alpha <= origAlpha) ? TT_UPPER_BOUND : TT_EXACT_SCORE);
+	}
+
+	if (beta <= alpha)
+		return TT_UPPER_BOUND;
+
+	return ((beta >= origBeta) ? TT_LOWER_BOUND : TT_EXACT_SCORE);
+}
+
+/**
+ * The function switches a score between the point of view of the maximizing player (the scores of the Minimax tree) and the
+ * point of view of the player that is its turn to play in a node (the scores of the transposition table, that are valid
+ * for every search). The scores are the same in a maximizing node, and opposite in a minimizing node.
+ *
+ * @param score    - The score to switch
+ * @param maximize - Indicates if the the node is a maximizing node or a minimizing node
+ *
+ * @return
+ * 		The score from the other point of view (INT_MIN and INT_MAX, the scores of a finished game, are switched with each other).
+ */
+int switchScoreView(int score, bool maximize) {
+	if (maximize)
+		return score;
+
+	if (score == INT_MIN)
+		return INT_MAX;
+
+	if (score == INT_MAX)
+		return INT_MIN;
+
+	return (-score);
+}
+
+/**
+ * The function switches a bound type between the point of view of the maximizing player and the point of view of the player
+ * that is its turn to play in a node (as in switchScoreView, a lower bound of one is an upper bound of the other in a minimizing node).
+ *
+ * @param bound    - The bound type to switch
+ * @param maximize - Indicates if the the node is a maximizing node or a minimizing node
+ *
+ * @return
+ * 		The bound type from the other point of view.
+ */
+TT_BOUND switchBoundView(TT_BOUND bound, bool maximize) {
+	if (maximize || (bound == TT_EXACT_SCORE))
+		return bound;
+
+	return ((bound == TT_LOWER_BOUND) ? TT_UPPER_BOUND : TT_LOWER_BOUND);
+}
+
 /**
  * The function updates (if needed) the alpha value or the beta value (respectively to what kind of node called to
  * the function - a maximizing node or a minimizing node).
  * In addition, if needed, updates the Minimax move (i.e. the move to be chosen by the Minimax algorithm) to be the
  * move that reached the highest scoring function so far.
  * That kind of updating of the Minimax move happens only when the function was called by the root node.
+ * The function returns whether the move improved the node's bound, so the caller can keep it as the node's best move.
  *
  * @param currMove     - The move that created the current node (i.e. the node that called the function)
  * @param minimaxMove  - The move that is currently the chosen move by the Minimax algorithm
@@ -149,26 +1183,29 @@ int alphaBetaPruning(SPChessGame* currentGame, Move* minimaxMove, int currDepth,
  * @param subtreeValue - The value that was returned to the current node (i.e. the node that called the function)
  *                        by the current subtree that was created in the Minimax tree
  * @param currDepth    - The current depth of the Minimax tree
- * @param choseMove    - The pointer to the indicator that denotes if so far at least one move was chosen as the move to be
- * 						  picked by the Minimax algorithm
+ * @param choseMove    - The pointer to the indicator that denotes if so far at least one move was chosen as the best move
+ * 						  of the current node (at the root node - the move to be picked by the Minimax algorithm)
  *
  * @return
- * 		INT_MAX - in case of a maxmizing node.
- * 		INT_MIN - in case of a minimizing node.
+ * 		True  - If the move improved the alpha value (in case of a maxmizing node) or the beta value (in case of a minimizing node).
+ * 		False - Otherwise.
  */
-void updateBoundsAndMove(Move* currMove, Move* minimaxMove, int* alpha, int* beta, bool maximize, int subtreeValue, int currDepth, bool* choseMove) {
+bool updateBoundsAndMove(PackedMove currMove, PackedMove* minimaxMove, int* alpha, int* beta, bool maximize, int subtreeValue, int currDepth, bool* choseMove) {
 	if (   (maximize)
 	    && ((subtreeValue > (*alpha)) || ((currDepth == ROOT_DEPTH) && !(*choseMove)))) {
 
 				*alpha = subtreeValue;
 
-				if (currDepth == ROOT_DEPTH) {
-					spMoveCopyData(currMove, minimaxMove);
-					*choseMove = true;
-				}
+				if (currDepth == ROOT_DEPTH)
+					*minimaxMove = currMove;
 	}
 	else if (!maximize && (subtreeValue < (*beta)))
 				*beta = subtreeValue;
+	else
+		return false;
+
+	*choseMove = true;
+	return true;
 }
 
 /**
@@ -202,49 +1239,32 @@ int leafNodeResult(SPChessGame* game, int maximizingPlayer) {
 
 /**
  * The function calculates the scoring for the maximizing player.
- * The function uses the values of each type of piece (defined in macros) to calculate the weighted values of the white/black armies.
- * At the end, the function subtract from the weighted value of the maximizing player's army the weighted value of the rival army.
- * Note that no need to include in the calculation the king because:
- * 1) On one hand, a player cannot have more than 1 king.
- * 2) On the other hand, we cannot get to a game board where one of the player doesn't have it's king (if there is a "checkmate"
- *     the game finishes so no "eating" of the king is actually possible).
+ * The material and the piece-square scores of both armies are kept in the evaluation accumulator of the game, that is updated
+ * incrementally as the moves are made and unmade (see SPChessEvaluation), so the scoring only blends its midgame and endgame
+ * scores by the game phase.
  *
  * @param game             - A Chess game
  * @param maximizingPlayer - The player which is its turn to play according to the root node of the tree.
  *
  * @return
- * 		The weighted value of the maximizing player's army minus the the weighted value of its rival's army.
+ * 		The evaluation of the position (in centipawns) from the point of view of the maximizing player.
  */
 int scoringFunction(SPChessGame* game, int maximizingPlayer) {
-	Army* whiteArmy = game->whiteArmy;
-	Army* blackArmy = game->blackArmy;
-
-	int whiteScore = (whiteArmy->numOfPawns * PAWN_SCORE) + (whiteArmy->numOfKnights * KNIGHT_SCORE) + (whiteArmy->numOfBishops * BISHOP_SCORE) +
-					 (whiteArmy->numOfRooks * ROOK_SCORE) + (whiteArmy->numOfQueens  * QUEEN_SCORE);
-	int blackScore = (blackArmy->numOfPawns * PAWN_SCORE) + (blackArmy->numOfKnights * KNIGHT_SCORE) + (blackArmy->numOfBishops * BISHOP_SCORE) +
-			         (blackArmy->numOfRooks * ROOK_SCORE) + (blackArmy->numOfQueens  * QUEEN_SCORE);
-
-	if (maximizingPlayer == WHITE_PLAYER) // White turn at the root node
-		return (whiteScore - blackScore);
-	else 	                              // Black turn at the root node
-		return (blackScore - whiteScore);
+	return spEvaluationScore(&(game->evaluation), (maximizingPlayer == WHITE_PLAYER));
 }
 
 /**
- * The function frees the memory allocation of the given array list (in case it is not NULL).
+ * The function returns the value of a node whose search failed because one of its moves couldn't be made
+ * (the value that denotes a memory error to the caller of the search, see spChessMinimaxTimedMove).
  *
- * @param pieceMoves - The array list that its memory should get freed
- * @param currDepth  - The current depth of the Minimax tree
- * @param maximize   - Indicates if the the function was called from a maximizing node or from a minimizing node
+ * @param currDepth - The current depth of the Minimax tree
+ * @param maximize  - Indicates if the the function was called from a maximizing node or from a minimizing node
  *
  * @return
- * 		INT_MAX - in case of a maxmizing node.
- * 		INT_MIN - in case of a minimizing node.
+ * 		INT_MIN - in case of the root node or a maxmizing node.
+ * 		INT_MAX - in case of a minimizing node.
  */
-int freeMemory(SPArrayList* pieceMoves, int currDepth, bool maximize) {
-	if (pieceMoves != NULL)
-		spArrayListDestroy(pieceMoves);
-
+int searchErrorResult(int currDepth, bool maximize) {
 	if (currDepth == ROOT_DEPTH)
 		return INT_MIN;
 
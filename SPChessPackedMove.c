@@ -0,0 +1,78 @@
+#include "SPChessPackedMove.h"
+
+/**
+ * The function creates a packed move of a regular move or a pawn promotion move.
+ *
+ * @param srcSquare     - The source square of the move
+ * @param dstSquare     - The destination square of the move
+ * @param promotionType - The type of the piece that a pawn is promoted to (PAWN_TYPE if the move is not a pawn promotion)
+ *
+ * @return
+ * 		The packed move.
+ */
+PackedMove spPackedMoveCreate(int srcSquare, int dstSquare, PIECE_TYPE promotionType) {
+	return (PackedMove) (  (srcSquare & PACKED_MOVE_SQUARE_MASK)
+						 | ((dstSquare & PACKED_MOVE_SQUARE_MASK)              << PACKED_MOVE_DST_SHIFT)
+						 | (((int) promotionType & PACKED_MOVE_PROMOTION_MASK) << PACKED_MOVE_PROMOTION_SHIFT));
+}
+
+/**
+ * The function creates a packed move of a castle move (a castle move is identified by its rook position only).
+ *
+ * @param rookSquare - The square of the rook that castles
+ *
+ * @return
+ * 		The packed move.
+ */
+PackedMove spPackedMoveCreateCastle(int rookSquare) {
+	return (PackedMove) (spPackedMoveCreate(rookSquare, rookSquare, PAWN_TYPE) | PACKED_MOVE_CASTLE_FLAG);
+}
+
+/**
+ * The function returns the source square of a packed move (the rook's square, for a castle move).
+ *
+ * @param move - A packed move
+ *
+ * @return
+ * 		The source square of the move.
+ */
+int spPackedMoveSrc(PackedMove move) {
+	return (move & PACKED_MOVE_SQUARE_MASK);
+}
+
+/**
+ * The function returns the destination square of a packed move (meaningless for a castle move).
+ *
+ * @param move - A packed move
+ *
+ * @return
+ * 		The destination square of the move.
+ */
+int spPackedMoveDst(PackedMove move) {
+	return ((move >> PACKED_MOVE_DST_SHIFT) & PACKED_MOVE_SQUARE_MASK);
+}
+
+/**
+ * The function returns the type of the piece that a packed move promotes a pawn to.
+ *
+ * @param move - A packed move
+ *
+ * @return
+ * 		The type of the piece the pawn is promoted to, or PAWN_TYPE if the move is not a pawn promotion.
+ */
+PIECE_TYPE spPackedMovePromotion(PackedMove move) {
+	return (PIECE_TYPE) ((move >> PACKED_MOVE_PROMOTION_SHIFT) & PACKED_MOVE_PROMOTION_MASK);
+}
+
+/**
+ * The function checks if a packed move is a castle move.
+ *
+ * @param move - A packed move
+ *
+ * @return
+ * 		True  - If the move is a castle move.
+ * 		False - Otherwise.
+ */
+bool spPackedMoveIsCastle(PackedMove move) {
+	return ((move & PACKED_MOVE_CASTLE_FLAG) != 0);
+}
@@ -0,0 +1,52 @@
+#ifndef SPCHESSPACKEDMOVE_H_
+#define SPCHESSPACKEDMOVE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "SPChessBitboard.h"
+
+/**
+ * SPChessPackedMove Summary:
+ *
+ * A packed move is a compact (16 bit) encoding of a move, that is used by the Minimax algorithm for its move lists,
+ * its killer moves and the best moves of the transposition table. It keeps only what identifies a move in its position:
+ *  bits 0-5   - The source square of the move (see SPChessBitboard)
+ *  bits 6-11  - The destination square of the move
+ *  bits 12-14 - The type of the piece that a pawn is promoted to (PAWN_TYPE if the move is not a pawn promotion)
+ *  bit  15    - The castling indicator
+ * A castle move is identified by its rook position only, so its destination square is its source square.
+ * No real move has the same source and destination squares without being a castle move, so 0 is used as the "null" packed move.
+ * The rest of the move (the moving piece, the captured piece and so on) is taken from the board of the position when the
+ * packed move is converted to a move of the game (see spChessGameUnpackMove).
+ *
+ * spPackedMoveCreate       - Creates a packed move of a regular move or a pawn promotion move
+ * spPackedMoveCreateCastle - Creates a packed move of a castle move
+ * spPackedMoveSrc          - Returns the source square of a packed move
+ * spPackedMoveDst          - Returns the destination square of a packed move
+ * spPackedMovePromotion    - Returns the type of the piece that a packed move promotes a pawn to
+ * spPackedMoveIsCastle     - Checks if a packed move is a castle move
+ */
+
+#define NULL_PACKED_MOVE             ((PackedMove) 0)
+#define MAX_POSITION_MOVES           256 // more than the legal moves of any position (at most 218), the size of a moves list
+#define PACKED_MOVE_SQUARE_MASK      0x3F
+#define PACKED_MOVE_DST_SHIFT        6
+#define PACKED_MOVE_PROMOTION_SHIFT  12
+#define PACKED_MOVE_PROMOTION_MASK   0x7
+#define PACKED_MOVE_CASTLE_FLAG      0x8000
+
+typedef uint16_t PackedMove;
+
+PackedMove spPackedMoveCreate(int srcSquare, int dstSquare, PIECE_TYPE promotionType);
+
+PackedMove spPackedMoveCreateCastle(int rookSquare);
+
+int spPackedMoveSrc(PackedMove move);
+
+int spPackedMoveDst(PackedMove move);
+
+PIECE_TYPE spPackedMovePromotion(PackedMove move);
+
+bool spPackedMoveIsCastle(PackedMove move);
+
+#endif
@@ -110,12 +110,13 @@ SPCommand spParserParseLine(const char* str, bool isSettingState){
 		}
 
 		else if ( (command.cmd == SP_DEFAULT || command.cmd == SP_QUIT || command.cmd == SP_PRINT_SETTING
-				|| command.cmd == SP_START || command.cmd == SP_UNDO_MOVE
+				|| command.cmd == SP_START || command.cmd == SP_UNDO_MOVE || command.cmd == SP_REDO_MOVE
 				|| command.cmd == SP_RESET) && second_word != NULL )
 			//command has 2 words although the command entered requires one word at most
 			command.cmd = SP_INVALID_LINE;
 
-		else if (command.cmd == SP_GAME_MODE || command.cmd == SP_DIFFICULTY || command.cmd == SP_USER_COLOR ){
+		else if (command.cmd == SP_GAME_MODE || command.cmd == SP_DIFFICULTY || command.cmd == SP_USER_COLOR
+				|| command.cmd == SP_JUMP_TO_PLY){
 			//command requires one word and one integer argument
 			if (spParserIsInt(second_word)){ //if 2nd word represents an integer
 				command.validIntArg = true;
@@ -172,6 +173,10 @@ SP_COMMAND spCommandParser(char* tokens, bool isSettingState){
 			return SP_SAVE;
 		if (!strcmp(tokens,UNDO))
 			return SP_UNDO_MOVE;
+		if (!strcmp(tokens,REDO))
+			return SP_REDO_MOVE;
+		if (!strcmp(tokens,JUMP))
+			return SP_JUMP_TO_PLY;
 		if (!strcmp(tokens,RESET))
 			return SP_RESET;
 		if (!strcmp(tokens, CASTLE))
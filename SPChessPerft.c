@@ -0,0 +1,211 @@
+#include "SPChessPerft.h"
+
+/**
+ * The regression table: well known perft positions (the initial position, "Kiwipete" and the positions 3 to 6 of the
+ * Chess Programming Wiki), a middle game position and a pawns endgame, with their node counts under the rules of this game.
+ */
+static const PerftPosition perftPositions[NUM_OF_PERFT_POSITIONS] = {
+	{ "initial",
+	  { "RNBQKBNR", "MMMMMMMM", "________", "________", "________", "________", "mmmmmmmm", "rnbqkbnr" },
+	  WHITE_PLAYER, true , true , true , true , { 20, 400, 8902, 197281 } },
+	{ "kiwipete",
+	  { "R___K__R", "M_MMQMB_", "BN__MNM_", "___mn___", "_M__m___", "__n__q_M", "mmmbbmmm", "r___k__r" },
+	  WHITE_PLAYER, true , true , true , true , { 48, 2037, 97718, 4074780 } },
+	{ "position 3",
+	  { "________", "__M_____", "___M____", "km_____R", "_r___M_K", "________", "____m_m_", "________" },
+	  WHITE_PLAYER, false, false, false, false, { 14, 191, 2810, 43087 } },
+	{ "position 4",
+	  { "R___K__R", "mMMM_MMM", "_B___NBn", "Nm______", "bbm_m___", "Q____n__", "mM_m__mm", "r__q_rk_" },
+	  WHITE_PLAYER, false, false, true , true , { 6, 258, 9217, 404818 } },
+	{ "position 5",
+	  { "RNBQ_K_R", "MM_mBMMM", "__M_____", "________", "__b_____", "________", "mmm_nNmm", "rnbqk__r" },
+	  WHITE_PLAYER, true , true , false, false, { 44, 1486, 62379, 2103487 } },
+	{ "position 6",
+	  { "R____RK_", "_MM_QMMM", "M_NM_N__", "__B_M_b_", "__b_m_B_", "m_nm_n__", "_mm_qmmm", "r____rk_" },
+	  WHITE_PLAYER, false, false, false, false, { 46, 2079, 89890, 3894594 } },
+	{ "middle game",
+	  { "R_BQK__R", "MM__BMMM", "__N_MN__", "___M____", "__mm____", "__n_mn__", "mm___mmm", "r_bqkb_r" },
+	  WHITE_PLAYER, true , true , true , true , { 35, 1288, 45307, 1707297 } },
+	{ "pawns endgame",
+	  { "________", "________", "____K___", "___M____", "___m_k__", "________", "_____m__", "________" },
+	  WHITE_PLAYER, false, false, false, false, { 6, 32, 238, 1613 } }
+};
+
+/**
+ * The function counts the leaf nodes of the tree of legal moves of the given game to the given depth. Every move is made
+ * in place and unmade when its subtree is counted, as in the Minimax algorithm. The moves of the last depth are only
+ * counted ("bulk counting"), since making them doesn't change the count.
+ *
+ * @param game  - A Chess game (it is the same when the function returns)
+ * @param depth - The depth of the tree
+ *
+ * @return
+ * 		The number of leaf nodes (1 for depth 0).
+ */
+long long spChessPerft(SPChessGame* game, int depth) {
+	if (depth <= 0)
+		return 1;
+
+	PackedMove moves[MAX_POSITION_MOVES];
+	int        numOfMoves = getPerftMoves(game, moves);
+
+	if (depth == 1)
+		return numOfMoves;
+
+	long long  nodes = 0;
+	Move       move;
+	UndoRecord undo;
+
+	for (int i = 0; i < numOfMoves; i++) {
+		spChessGameUnpackMove(game, moves[i], &move);
+		spChessGameMakeMove(game, &move, &undo);
+
+		nodes += spChessPerft(game, depth - 1);
+
+		spChessGameUnmakeMove(game, &move, &undo);
+	}
+
+	return nodes;
+}
+
+/**
+ * The function counts the leaf nodes under every legal move of the given game to the given depth, and prints every move
+ * with its count ("divide"). When a count is wrong, comparing the counts of the moves with the known counts finds the move
+ * whose subtree is wrong, and dividing again after that move narrows it down to the wrong position.
+ *
+ * @param game  - A Chess game (it is the same when the function returns)
+ * @param depth - The depth of the tree (at least 1)
+ *
+ * @return
+ * 		The number of leaf nodes of the whole tree.
+ */
+long long spChessPerftDivide(SPChessGame* game, int depth) {
+	PackedMove moves[MAX_POSITION_MOVES];
+	int        numOfMoves = getPerftMoves(game, moves);
+	long long  nodes      = 0;
+	Move       move;
+	UndoRecord undo;
+
+	for (int i = 0; i < numOfMoves; i++) {
+		spChessGameUnpackMove(game, moves[i], &move);
+		spChessGameMakeMove(game, &move, &undo);
+
+		long long moveNodes = spChessPerft(game, depth - 1);
+
+		spChessGameUnmakeMove(game, &move, &undo);
+
+		printPerftMove(&move, moveNodes);
+		nodes += moveNodes;
+	}
+
+	return nodes;
+}
+
+/**
+ * The function counts the nodes of every position of the regression table to every depth up to the given depth
+ * (and up to PERFT_TABLE_DEPTH), and prints every count next to its known count. Then, the total number of nodes
+ * and the speed of the counting are printed.
+ *
+ * @param maxDepth - The maximum depth to check
+ *
+ * @return
+ * 		False - If any count is different from its known count, or if a memory error occurred.
+ * 		True  - Otherwise.
+ */
+bool spChessPerftRegression(int maxDepth) {
+	SPChessGame* game = spChessGameCreate();
+	if (game == NULL)
+		return false;
+
+	bool      allPassed  = true;
+	long long totalNodes = 0;
+	long long startTime  = spTimerNowMs();
+
+	if (maxDepth > PERFT_TABLE_DEPTH)
+		maxDepth = PERFT_TABLE_DEPTH;
+
+	for (int positionNum = 0; positionNum < NUM_OF_PERFT_POSITIONS; positionNum++) {
+		const PerftPosition* position = &(perftPositions[positionNum]);
+		setPerftPosition(game, position);
+
+		for (int depth = 1; depth <= maxDepth; depth++) {
+			long long nodes  = spChessPerft(game, depth);
+			bool      passed = (nodes == position->nodes[depth - 1]);
+
+			PRINT_PERFT_REGRESSION_RESULT(position->name, depth, nodes, position->nodes[depth - 1], passed);
+			allPassed   = (allPassed && passed);
+			totalNodes += nodes;
+		}
+	}
+
+	printPerftSummary(totalNodes, spTimerNowMs() - startTime);
+	spChessGameDestroy(game);
+
+	return allPassed;
+}
+
+/**
+ * The function generates all the legal moves of the current player (by calling getPossiblePackedMoves).
+ * The game status is set from the legality masks first, because it is not calculated when a move is made,
+ * and a castle move is not legal under "check".
+ *
+ * @param game  - A Chess game
+ * @param moves - The array where the moves will be added to (its size is MAX_POSITION_MOVES)
+ *
+ * @return
+ * 		The number of legal moves.
+ */
+int getPerftMoves(SPChessGame* game, PackedMove moves[]) {
+	LegalityMasks masks;
+	getLegalityMasks(game, &masks);
+	game->status = unfinishedGameStatus(&masks);
+
+	return getPossiblePackedMoves(game, moves, &masks, false);
+}
+
+/**
+ * The function prints a move of the "divide" with its count (the positions are printed as in the console mode).
+ *
+ * @param move  - A move that was made and unmade (a castle move is printed by its rook position)
+ * @param nodes - The number of leaf nodes under the move
+ */
+void printPerftMove(const Move* move, long long nodes) {
+	int  srcRow = move->srcRow + 1;
+	char srcCol = (char) (PERFT_FIRST_COL_LETTER + move->srcCol);
+
+	if (move->castleMove) {
+		PRINT_PERFT_CASTLE_MOVE(srcRow, srcCol, nodes);
+		return;
+	}
+
+	int  dstRow = move->dstRow + 1;
+	char dstCol = (char) (PERFT_FIRST_COL_LETTER + move->dstCol);
+
+	if (move->pawnPromotion)
+		PRINT_PERFT_PROMOTION_MOVE(srcRow, srcCol, dstRow, dstCol, move->srcPiece, nodes);
+	else
+		PRINT_PERFT_REGULAR_MOVE(srcRow, srcCol, dstRow, dstCol, nodes);
+}
+
+/**
+ * The function prints the total number of nodes that were counted, the time it took and the counting speed.
+ *
+ * @param nodes     - The number of nodes
+ * @param elapsedMs - The time of the counting in milliseconds
+ */
+void printPerftSummary(long long nodes, long long elapsedMs) {
+	long long nodesPerSecond = (nodes * MS_IN_SECOND) / ((elapsedMs > 0) ? elapsedMs : 1);
+
+	PRINT_PERFT_SUMMARY(nodes, elapsedMs, nodesPerSecond);
+}
+
+/**
+ * The function sets the given game to a position of the regression table (by calling setGamePosition).
+ *
+ * @param game     - A Chess game
+ * @param position - A position of the regression table
+ */
+void setPerftPosition(SPChessGame* game, const PerftPosition* position) {
+	setGamePosition(game, position->rows, position->currentPlayer, position->whiteLeftCastle, position->whiteRightCastle,
+					position->blackLeftCastle, position->blackRightCastle);
+}
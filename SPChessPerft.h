@@ -0,0 +1,60 @@
+#ifndef SPCHESSPERFT_H_
+#define SPCHESSPERFT_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "SPChessGame.h"
+#include "SPChessTimer.h"
+
+/**
+ * SPChessPerft Summary:
+ *
+ * "Perft" (performance test) counts the leaf nodes of the full tree of legal moves to a given depth, using the move generator
+ * of the Minimax algorithm (see getPossiblePackedMoves) and the in-place make/unmake of the search. Comparing the counts with
+ * known counts verifies the move generator, and the time it takes measures its speed.
+ * The known counts of the regression table follow the rules of this game, that has no "en passant" capture, so some of them
+ * differ from the counts that are usually published for the same positions.
+ *
+ * spChessPerft           - Counts the leaf nodes of the legal moves tree of a game to a given depth
+ * spChessPerftDivide     - Counts and prints the leaf nodes under every legal move of a game ("divide")
+ * spChessPerftRegression - Checks the counts of all the positions of the regression table and prints the results
+ * setPerftPosition       - Sets a game to a position of the regression table
+ */
+
+#define PERFT_TABLE_DEPTH      4
+#define NUM_OF_PERFT_POSITIONS 8
+#define PERFT_FIRST_COL_LETTER 'A'
+
+#define PRINT_PERFT_REGULAR_MOVE(sr, sc, dr, dc, n)       printf("<%d,%c> -> <%d,%c>: %lld\n", sr, sc, dr, dc, n)
+#define PRINT_PERFT_PROMOTION_MOVE(sr, sc, dr, dc, p, n)  printf("<%d,%c> -> <%d,%c> promotion to %c: %lld\n", sr, sc, dr, dc, p, n)
+#define PRINT_PERFT_CASTLE_MOVE(sr, sc, n)                printf("castle <%d,%c>: %lld\n", sr, sc, n)
+#define PRINT_PERFT_REGRESSION_RESULT(name, d, n, e, ok)  printf("%-16s depth %d: %12lld (expected %12lld) %s\n", name, d, n, e, ((ok) ? "OK" : "FAILED"))
+#define PRINT_PERFT_SUMMARY(n, ms, nps)                   printf("Nodes: %lld\nTime: %lld ms\nNodes per second: %lld\n", n, ms, nps)
+
+/**
+ * A position of the regression table: its board (from the 8th row down to the 1st row, as in a saved game file), the player
+ * that is its turn to play, its castling indicators and the known node counts of depths 1 to PERFT_TABLE_DEPTH.
+ */
+typedef struct perft_position_t {
+	const char* name;
+	const char* rows[BOARD_LENGTH];
+	int         currentPlayer;
+	bool        whiteLeftCastle, whiteRightCastle, blackLeftCastle, blackRightCastle;
+	long long   nodes[PERFT_TABLE_DEPTH];
+} PerftPosition;
+
+long long spChessPerft(SPChessGame* game, int depth);
+
+long long spChessPerftDivide(SPChessGame* game, int depth);
+
+bool spChessPerftRegression(int maxDepth);
+
+int getPerftMoves(SPChessGame* game, PackedMove moves[]);
+
+void printPerftMove(const Move* move, long long nodes);
+
+void printPerftSummary(long long nodes, long long elapsedMs);
+
+void setPerftPosition(SPChessGame* game, const PerftPosition* position);
+
+#endif
@@ -18,10 +18,11 @@ GameSetting* copySettings(GameSetting* src, bool copyGame) {
 	if (dest == NULL)
 		return NULL;
 
-	dest->gameMode     = src->gameMode;
-	dest->difficulty   = src->difficulty;
-	dest->userColor    = src->userColor;
-	dest->isGameLoaded = src->isGameLoaded;
+	dest->gameMode      = src->gameMode;
+	dest->difficulty    = src->difficulty;
+	dest->searchThreads = src->searchThreads;
+	dest->userColor     = src->userColor;
+	dest->isGameLoaded  = src->isGameLoaded;
 
 	if (copyGame) {
 		SPChessGame* game = spChessGameCopy(src->game);
@@ -93,6 +94,7 @@ void setDifficulty(GameSetting* setting, SPCommand command){
  * Resets the game setting to the default values:
  * The game mode 					- the default value is 1 (1-player mode)
  * The difficulty level of the game - the default value is 2 (easy level)
+ * The threads of the computer's search - the default value is DEFAULT_SEARCH_THREADS
  * User color						- the default value is 1 (white)
  *
  * @param setting - the game setting to be updated
@@ -101,6 +103,7 @@ void setDifficulty(GameSetting* setting, SPCommand command){
 void setDefaultValues(GameSetting* setting){
 	setting->gameMode = ONE_PLAYER_MODE;
 	setting->difficulty = EASY_LEVEL;
+	setting->searchThreads = DEFAULT_SEARCH_THREADS;
 	setting->userColor = WHITE_PLAYER;
 	setting->isGameLoaded = GAME_NOT_LOADED_YET;
 	setting->game = NULL;
@@ -194,7 +197,7 @@ void loadGame(const char* fileName, GameSetting* setting){
 		LOAD_PERROR;
 		return;
 	}
-	setting->game = spChessGameCreate(HISTORY_SIZE); // create a new game inside the structure of the setting
+	setting->game = spChessGameCreate(); // create a new game inside the structure of the setting
 	if (setting->game == NULL){
 		MEMORY_ALLOCATION_PERROR;
 		setting->isGameLoaded = MEMORY_ALLOCATION_ERROR_DURING_LOADING;
@@ -225,6 +228,7 @@ void loadGame(const char* fileName, GameSetting* setting){
 	while ((fscanf(file, "%s", str) == 1) && (boardRowParser(setting, str, row) != LOAD_EXIT_LOOP)){
 		row--; //inside board tag, we keep looping until we reach the board closing tag
 	}
+	initializeBitboards(setting->game); // the board was filled directly, so the bitboards are built from it
 
 	while ((fscanf(file, "%s", str) == 1) && !(hasReachedTheNextTag(str ,GENERAL_OPENING_TAG))){
 		//the scanning to str is until we reach the general opening tag
@@ -245,6 +249,9 @@ void loadGame(const char* fileName, GameSetting* setting){
 	}
 
 	fclose(file);
+	// the whole position was loaded (including the current player and the castling indicators), so its key and its evaluation are computed from scratch
+	setting->game->zobristKey = computeZobristKey(setting->game);
+	setting->game->evaluation = computeEvaluation(setting->game);
 	setting->isGameLoaded = GAME_LOADED_SUCCESSFULLY;
 }
 
@@ -0,0 +1,18 @@
+#define _POSIX_C_SOURCE 199309L // for clock_gettime (must be defined before any system header is included)
+
+#include <time.h>
+#include "SPChessTimer.h"
+
+/**
+ * The function returns the current time of a monotonic clock (that is not affected by changes of the system time),
+ * so only the difference between two returned values is meaningful.
+ *
+ * @return
+ * 		The current time in milliseconds.
+ */
+long long spTimerNowMs(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (((long long) now.tv_sec * MS_IN_SECOND) + (now.tv_nsec / NS_IN_MS));
+}
@@ -0,0 +1,19 @@
+#ifndef SPCHESSTIMER_H_
+#define SPCHESSTIMER_H_
+
+#include <stdbool.h>
+
+/**
+ * SPChessTimer Summary:
+ *
+ * A monotonic wall-clock in milliseconds, used for limiting the time of a search and for measuring it.
+ *
+ * spTimerNowMs - Returns the current time in milliseconds (from an arbitrary starting point)
+ */
+
+#define MS_IN_SECOND 1000
+#define NS_IN_MS     1000000
+
+long long spTimerNowMs(void);
+
+#endif
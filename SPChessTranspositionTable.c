@@ -0,0 +1,232 @@
+#include "SPChessTranspositionTable.h"
+
+/**
+ * The table and its state (allocated once by spChessTTInit).
+ */
+static TTBucket* table          = NULL;
+static uint64_t  bucketsMask    = 0;
+static uint8_t   currGeneration = 0;
+
+/**
+ * The function allocates the table with the largest power of two number of buckets that fits in the given size.
+ * If the table was already allocated, it is replaced by the new table (i.e. this also resizes the table).
+ * If the allocation fails, the searches simply run without a table.
+ *
+ * @param sizeInMB - The size of the table in MB
+ *
+ * @return
+ * 		False - If sizeInMB is not positive or an allocation error occurred.
+ * 		True  - Otherwise.
+ */
+bool spChessTTInit(int sizeInMB) {
+	spChessTTDestroy();
+
+	if (sizeInMB <= 0)
+		return false;
+
+	uint64_t bucketsAmount = 1;
+	while ((bucketsAmount * 2 * sizeof(TTBucket)) <= ((uint64_t) sizeInMB * TT_BYTES_IN_MB))
+		bucketsAmount *= 2;
+
+	table = (TTBucket*) calloc(bucketsAmount, sizeof(TTBucket)); // all the entries are empty (TT_EMPTY_ENTRY is 0)
+	if (table == NULL)
+		return false;
+
+	bucketsMask = bucketsAmount - 1;
+
+	return true;
+}
+
+/**
+ * The function frees the table (if it was allocated).
+ */
+void spChessTTDestroy(void) {
+	free(table);
+
+	table       = NULL;
+	bucketsMask = 0;
+}
+
+/**
+ * The function empties all the entries of the table, so no result of a previous search is used.
+ */
+void spChessTTClear(void) {
+	if (table != NULL)
+		memset(table, 0, (bucketsMask + 1) * sizeof(TTBucket));
+}
+
+/**
+ * The function marks the beginning of a new search. The entries that were stored by previous searches
+ * are still probed, but a depth-preferred entry of a previous search is replaced regardless of its depth.
+ */
+void spChessTTNewSearch(void) {
+	currGeneration = (uint8_t) ((currGeneration + 1) & TT_GENERATION_MASK);
+}
+
+/**
+ * The function looks up the entry of the position with the given key (the depth-preferred entry of the bucket is checked first).
+ *
+ * @param key   - The Zobrist key of the position
+ * @param entry - The entry to be filled with a copy of the position's entry (if one was found)
+ *
+ * @return
+ * 		True  - If an entry of the position was found.
+ * 		False - Otherwise.
+ */
+bool spChessTTProbe(ZobristKey key, TTEntry* entry) {
+	if (table == NULL)
+		return false;
+
+	TTBucket* bucket = &(table[key & bucketsMask]);
+
+	return (readSlot(&(bucket->depthPreferred), key, entry) || readSlot(&(bucket->alwaysReplace), key, entry));
+}
+
+/**
+ * The function stores a search result of the position with the given key.
+ * The result replaces the depth-preferred entry of the bucket if that entry belongs to the same position, if it was stored
+ * by a previous search, or if the new result was searched at least as deep. Otherwise the always-replace entry gets it.
+ * When no best move was found (bestMove is NULL_PACKED_MOVE), the best move that was already kept for the position (if any) is kept.
+ *
+ * @param key      - The Zobrist key of the position
+ * @param depth    - The remaining search depth of the result
+ * @param bound    - The bound type of the score
+ * @param score    - The score of the position, from the point of view of the player that is its turn to play
+ * @param bestMove - The best move that was found in the position (NULL_PACKED_MOVE if no move was found)
+ */
+void spChessTTStore(ZobristKey key, int depth, TT_BOUND bound, int score, PackedMove bestMove) {
+	if (table == NULL)
+		return;
+
+	TTBucket* bucket = &(table[key & bucketsMask]);
+	TTSlot*   slot   = &(bucket->depthPreferred);
+	TTEntry   oldEntry;
+	uint64_t  checkKey;
+	uint64_t  data    = loadSlot(slot, &checkKey); // the depth-preferred slot is loaded once for both of its checks
+	bool      sameKey = slotEntry(data, checkKey, key, &oldEntry);
+
+	if (!sameKey) {
+		unpackEntry(data, &oldEntry);
+
+		if ((oldEntry.bound != TT_EMPTY_ENTRY) && (oldEntry.generation == currGeneration) && (depth < oldEntry.depth)) {
+			slot    = &(bucket->alwaysReplace);
+			sameKey = readSlot(slot, key, &oldEntry);
+		}
+	}
+
+	TTEntry entry;
+
+	entry.key        = key;
+	entry.score      = score;
+	entry.depth      = (int8_t) depth;
+	entry.bound      = (uint8_t) bound;
+	entry.generation = currGeneration;
+	entry.bestMove   = (((bestMove == NULL_PACKED_MOVE) && sameKey) ? oldEntry.bestMove : bestMove); // keeps the old best move
+
+	writeSlot(slot, key, &entry);
+}
+
+/**
+ * The function reads the entry that is kept in the given slot, if it belongs to the position with the given key.
+ * The slot is read only once (see loadSlot), so an entry that another thread is writing at the same time is either fully read
+ * or doesn't match.
+ *
+ * @param slot  - A slot of the table
+ * @param key   - The Zobrist key of the position
+ * @param entry - The entry to be filled with the unpacked entry of the slot (if it belongs to the position)
+ *
+ * @return
+ * 		True  - If the slot holds an entry of the position.
+ * 		False - Otherwise.
+ */
+bool readSlot(const TTSlot* slot, ZobristKey key, TTEntry* entry) {
+	uint64_t checkKey;
+	uint64_t data = loadSlot(slot, &checkKey);
+
+	return slotEntry(data, checkKey, key, entry);
+}
+
+/**
+ * The function loads the two words of the given slot. The slot is shared by all the threads of the search without a lock, so its
+ * words are loaded atomically (each on its own), and the compiler can't load them again after they were checked (see slotEntry).
+ *
+ * @param slot     - A slot of the table
+ * @param checkKey - Filled with the check key of the slot
+ *
+ * @return
+ * 		The packed data of the slot.
+ */
+uint64_t loadSlot(const TTSlot* slot, uint64_t* checkKey) {
+	*checkKey = __atomic_load_n(&(slot->checkKey), __ATOMIC_RELAXED);
+
+	return __atomic_load_n(&(slot->data), __ATOMIC_RELAXED);
+}
+
+/**
+ * The function unpacks the loaded words of a slot, if they hold an entry of the position with the given key. The check key is
+ * the position's key XORed with the data, so a slot whose words were written by two different stores doesn't match.
+ *
+ * @param data     - The packed data of the slot
+ * @param checkKey - The check key of the slot
+ * @param key      - The Zobrist key of the position
+ * @param entry    - The entry to be filled with the unpacked entry of the slot (if it belongs to the position)
+ *
+ * @return
+ * 		True  - If the slot holds an entry of the position.
+ * 		False - Otherwise.
+ */
+bool slotEntry(uint64_t data, uint64_t checkKey, ZobristKey key, TTEntry* entry) {
+	if (((checkKey ^ data) != key) || (((data >> TT_BOUND_SHIFT) & TT_BOUND_MASK) == TT_EMPTY_ENTRY))
+		return false;
+
+	unpackEntry(data, entry);
+	entry->key = key;
+
+	return true;
+}
+
+/**
+ * The function writes the given entry of the position with the given key to the given slot.
+ *
+ * @param slot  - A slot of the table
+ * @param key   - The Zobrist key of the position
+ * @param entry - The entry to write
+ */
+void writeSlot(TTSlot* slot, ZobristKey key, const TTEntry* entry) {
+	uint64_t data = packEntry(entry);
+
+	// the words are stored atomically, because other threads may load the slot at the same time (see loadSlot)
+	__atomic_store_n(&(slot->checkKey), (key ^ data), __ATOMIC_RELAXED);
+	__atomic_store_n(&(slot->data)    , data        , __ATOMIC_RELAXED);
+}
+
+/**
+ * The function packs an entry into one 64 bit word (the key is not packed). The best move is already packed (see SPChessPackedMove),
+ * so it simply takes the highest 16 bits.
+ *
+ * @param entry - An entry
+ *
+ * @return
+ * 		The packed data of the entry.
+ */
+uint64_t packEntry(const TTEntry* entry) {
+	return (  ((uint64_t) (uint32_t) entry->score)
+			| (((uint64_t) entry->depth & TT_DEPTH_MASK)           << TT_DEPTH_SHIFT)
+			| (((uint64_t) entry->bound & TT_BOUND_MASK)           << TT_BOUND_SHIFT)
+			| (((uint64_t) entry->generation & TT_GENERATION_MASK) << TT_GENERATION_SHIFT)
+			| (((uint64_t) entry->bestMove & TT_MOVE_MASK)         << TT_MOVE_SHIFT));
+}
+
+/**
+ * The function unpacks the packed data of an entry (the key of the entry is not set).
+ *
+ * @param data  - The packed data of an entry
+ * @param entry - The entry to be filled
+ */
+void unpackEntry(uint64_t data, TTEntry* entry) {
+	entry->score      = (int) (int32_t) (uint32_t) (data & TT_SCORE_MASK);
+	entry->depth      = (int8_t) ((data >> TT_DEPTH_SHIFT) & TT_DEPTH_MASK);
+	entry->bound      = (uint8_t) ((data >> TT_BOUND_SHIFT) & TT_BOUND_MASK);
+	entry->generation = (uint8_t) ((data >> TT_GENERATION_SHIFT) & TT_GENERATION_MASK);
+	entry->bestMove   = (PackedMove) ((data >> TT_MOVE_SHIFT) & TT_MOVE_MASK);
+}
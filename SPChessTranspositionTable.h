@@ -0,0 +1,107 @@
+#ifndef SPCHESSTRANSPOSITIONTABLE_H_
+#define SPCHESSTRANSPOSITIONTABLE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SPChessGameAux.h"
+#include "SPChessPackedMove.h"
+
+/**
+ * SPChessTranspositionTable Summary:
+ *
+ * A fixed-size hash table of search results, indexed by the Zobrist key of the searched position.
+ * The table size is a power of two, so the bucket of a key is selected by its low bits. Every bucket holds two entries:
+ * a "depth-preferred" entry, that is replaced only by a result of a search that is at least as deep (or by a result of
+ * a newer search), and an "always-replace" entry, that gets every other result.
+ * An entry holds the remaining search depth of its result, the bound type of its score, the score itself (from the point of view
+ * of the player that is its turn to play in the position) and the best move that was found.
+ * There is a single table for the whole program, and it is shared by the threads of a search without any lock: an entry is kept
+ * as one packed 64 bit word of data and the key of its position XORed with that data, so an entry that was read while another
+ * thread was writing it (half of the old entry and half of the new one) simply doesn't match the key of the probed position.
+ *
+ * spChessTTInit         - Allocates the table with the given size in MB (called once at startup)
+ * spChessTTDestroy      - Frees the table
+ * spChessTTClear        - Empties all the entries of the table
+ * spChessTTNewSearch    - Marks the beginning of a new search (entries of older searches become replaceable)
+ * spChessTTProbe        - Looks up the entry of a position
+ * spChessTTStore        - Stores a search result of a position
+ */
+
+#define TT_DEFAULT_SIZE_MB 16
+#define TT_BYTES_IN_MB     (1024 * 1024)
+
+// the layout of the packed data of an entry (the score takes the lowest 32 bits)
+#define TT_DEPTH_SHIFT      32
+#define TT_BOUND_SHIFT      39
+#define TT_GENERATION_SHIFT 41
+#define TT_MOVE_SHIFT       48
+#define TT_SCORE_MASK       0xFFFFFFFFULL
+#define TT_DEPTH_MASK       0x7F
+#define TT_BOUND_MASK       0x3
+#define TT_GENERATION_MASK  0x7F
+#define TT_MOVE_MASK        0xFFFF
+
+/**
+ * The bound type of a score that is kept in an entry (an empty entry has no bound).
+ * An exact score is the value of the position, a lower bound means the value is at least the score (the search was cut off),
+ * and an upper bound means the value is at most the score (no move reached the lower bound of the search).
+ */
+typedef enum tt_bound_t {
+	TT_EMPTY_ENTRY,
+	TT_EXACT_SCORE,
+	TT_LOWER_BOUND,
+	TT_UPPER_BOUND
+} TT_BOUND;
+
+/**
+ * An unpacked entry, as it is returned by a probe.
+ * The best move of an entry is kept as a packed move (see SPChessPackedMove), and an entry without a best move keeps NULL_PACKED_MOVE.
+ */
+typedef struct tt_entry_t {
+	ZobristKey key;
+	int        score;
+	int8_t     depth;
+	uint8_t    bound;
+	uint8_t    generation;
+	PackedMove bestMove;
+} TTEntry;
+
+/**
+ * A packed entry, as it is kept in the table (checkKey is the key of the entry's position XORed with its data).
+ */
+typedef struct tt_slot_t {
+	uint64_t checkKey;
+	uint64_t data;
+} TTSlot;
+
+typedef struct tt_bucket_t {
+	TTSlot depthPreferred;
+	TTSlot alwaysReplace;
+} TTBucket;
+
+bool spChessTTInit(int sizeInMB);
+
+void spChessTTDestroy(void);
+
+void spChessTTClear(void);
+
+void spChessTTNewSearch(void);
+
+bool spChessTTProbe(ZobristKey key, TTEntry* entry);
+
+void spChessTTStore(ZobristKey key, int depth, TT_BOUND bound, int score, PackedMove bestMove);
+
+bool readSlot(const TTSlot* slot, ZobristKey key, TTEntry* entry);
+
+uint64_t loadSlot(const TTSlot* slot, uint64_t* checkKey);
+
+bool slotEntry(uint64_t data, uint64_t checkKey, ZobristKey key, TTEntry* entry);
+
+void writeSlot(TTSlot* slot, ZobristKey key, const TTEntry* entry);
+
+uint64_t packEntry(const TTEntry* entry);
+
+void unpackEntry(uint64_t data, TTEntry* entry);
+
+#endif
@@ -0,0 +1,175 @@
+#include "SPChessUndoStack.h"
+
+/**
+ * The function creates an empty undo stack. No chunk is allocated until the first move is pushed,
+ * so the games that never save a move (the copies of the Minimax algorithm) stay cheap to create.
+ *
+ * @return
+ * 		NULL if a memory allocation failure occurred.
+ * 		Otherwise, a new empty undo stack.
+ */
+SPUndoStack* spUndoStackCreate(void) {
+	SPUndoStack* stack = (SPUndoStack*) malloc(sizeof(SPUndoStack));
+	if (stack == NULL)
+		return NULL;
+
+	stack->chunks         = NULL;
+	stack->numOfChunks    = 0;
+	stack->chunksCapacity = 0;
+	stack->size           = 0;
+	stack->ply            = 0;
+
+	return stack;
+}
+
+/**
+ * The function frees all the memory of the given undo stack. If (stack == NULL) the function does nothing.
+ *
+ * @param stack - An undo stack
+ */
+void spUndoStackDestroy(SPUndoStack* stack) {
+	if (stack == NULL)
+		return;
+
+	for (int chunkNum = 0; chunkNum < stack->numOfChunks; chunkNum++)
+		free(stack->chunks[chunkNum]);
+
+	free(stack->chunks);
+	free(stack);
+}
+
+/**
+ * The function adds the entry of a move that was played. The moves that were undone can't be redone anymore
+ * (the new move replaces them), so their entries are discarded.
+ *
+ * @param stack - An undo stack
+ * @param entry - The entry of the played move
+ *
+ * @return
+ * 		SP_UNDO_STACK_INVALID_ARGUMENT - If either stack is NULL or entry is NULL.
+ * 		SP_UNDO_STACK_MEMORY_FAILURE   - If a new chunk was needed and couldn't be allocated.
+ * 		SP_UNDO_STACK_SUCCESS          - Otherwise.
+ */
+SP_UNDO_STACK_MESSAGE spUndoStackPush(SPUndoStack* stack, const UndoEntry* entry) {
+	if ((stack == NULL) || (entry == NULL))
+		return SP_UNDO_STACK_INVALID_ARGUMENT;
+
+	if ((stack->ply == (stack->numOfChunks * UNDO_CHUNK_SIZE)) && !addUndoChunk(stack))
+		return SP_UNDO_STACK_MEMORY_FAILURE;
+
+	stack->chunks[stack->ply / UNDO_CHUNK_SIZE][stack->ply % UNDO_CHUNK_SIZE] = *entry;
+	stack->ply++;
+	stack->size = stack->ply;
+
+	return SP_UNDO_STACK_SUCCESS;
+}
+
+/**
+ * The function marks the last played move as undone (it can be redone until a new move is pushed), and returns its entry.
+ *
+ * @param stack - An undo stack
+ *
+ * @return
+ * 		NULL if either stack is NULL or no move was played.
+ * 		Otherwise, the entry of the undone move.
+ */
+UndoEntry* spUndoStackUndo(SPUndoStack* stack) {
+	if ((stack == NULL) || (stack->ply == 0))
+		return NULL;
+
+	stack->ply--;
+
+	return spUndoStackGetAt(stack, stack->ply);
+}
+
+/**
+ * The function marks the first undone move (i.e. the last move that was undone) as played again, and returns its entry.
+ *
+ * @param stack - An undo stack
+ *
+ * @return
+ * 		NULL if either stack is NULL or there is no undone move.
+ * 		Otherwise, the entry of the redone move.
+ */
+UndoEntry* spUndoStackRedo(SPUndoStack* stack) {
+	if ((stack == NULL) || (stack->ply == stack->size))
+		return NULL;
+
+	stack->ply++;
+
+	return spUndoStackGetAt(stack, stack->ply - 1);
+}
+
+/**
+ * The function returns the entry at the given index (the entry of the move that was played at the given ply).
+ *
+ * @param stack - An undo stack
+ * @param index - The index of the entry (0-based)
+ *
+ * @return
+ * 		NULL if either stack is NULL or the index is out of bound.
+ * 		Otherwise, the entry at the given index.
+ */
+UndoEntry* spUndoStackGetAt(SPUndoStack* stack, int index) {
+	if ((stack == NULL) || (index < 0) || (index >= stack->size))
+		return NULL;
+
+	return &(stack->chunks[index / UNDO_CHUNK_SIZE][index % UNDO_CHUNK_SIZE]);
+}
+
+/**
+ * The function returns the number of moves that are currently played.
+ *
+ * @param stack - An undo stack
+ *
+ * @return
+ * 		-1 if stack is NULL.
+ * 		Otherwise, the number of played moves.
+ */
+int spUndoStackPly(SPUndoStack* stack) {
+	return (stack == NULL) ? -1 : stack->ply;
+}
+
+/**
+ * The function returns the number of entries of the stack: the played moves and the undone moves that can be redone.
+ *
+ * @param stack - An undo stack
+ *
+ * @return
+ * 		-1 if stack is NULL.
+ * 		Otherwise, the number of entries.
+ */
+int spUndoStackSize(SPUndoStack* stack) {
+	return (stack == NULL) ? -1 : stack->size;
+}
+
+/**
+ * The function adds a new chunk to the given undo stack. The array of the chunk pointers is doubled when it's full;
+ * the chunks themselves are never moved, so the entries are not copied and their addresses stay valid.
+ *
+ * @param stack - An undo stack
+ *
+ * @return
+ * 		False - If a memory allocation failure occurred (the stack is not changed).
+ * 		True  - Otherwise.
+ */
+bool addUndoChunk(SPUndoStack* stack) {
+	if (stack->numOfChunks == stack->chunksCapacity) {
+		int         capacity = (stack->chunksCapacity == 0) ? INITIAL_UNDO_CHUNKS : (stack->chunksCapacity * 2);
+		UndoEntry** chunks   = (UndoEntry**) realloc(stack->chunks, capacity * sizeof(UndoEntry*));
+		if (chunks == NULL)
+			return false;
+
+		stack->chunks         = chunks;
+		stack->chunksCapacity = capacity;
+	}
+
+	UndoEntry* chunk = (UndoEntry*) malloc(UNDO_CHUNK_SIZE * sizeof(UndoEntry));
+	if (chunk == NULL)
+		return false;
+
+	stack->chunks[stack->numOfChunks] = chunk;
+	stack->numOfChunks++;
+
+	return true;
+}
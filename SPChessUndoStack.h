@@ -0,0 +1,77 @@
+#ifndef SPCHESSUNDOSTACK_H_
+#define SPCHESSUNDOSTACK_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "SPChessPackedMove.h"
+
+/**
+ * SPChessUndoStack Summary:
+ *
+ * The history of a game: a stack of the moves that were played, that also keeps the moves that were undone (until a new move
+ * is played), so they can be redone. Every entry is a compact delta of the game state (8 bytes): the move itself, the piece it
+ * captured, the castling indicators and the game status before it, and the game status after it. A move is undone or redone
+ * from its entry alone, in constant time, so the game can jump to any ply of its history.
+ * The entries are kept in chunks of UNDO_CHUNK_SIZE entries that are never moved, so the stack grows without a limit and without
+ * copying its entries (only the array of the chunk pointers is reallocated when it's full).
+ *
+ * spUndoStackCreate  - Creates an empty undo stack
+ * spUndoStackDestroy - Frees all the memory of an undo stack
+ * spUndoStackPush    - Adds the entry of a played move (the undone moves can't be redone anymore)
+ * spUndoStackUndo    - Returns the entry of the last played move, and marks it as undone
+ * spUndoStackRedo    - Returns the entry of the first undone move, and marks it as played
+ * spUndoStackGetAt   - Returns the entry at a given index
+ * spUndoStackPly     - Returns the number of played moves
+ * spUndoStackSize    - Returns the number of entries (played and undone moves)
+ */
+
+#define UNDO_CHUNK_SIZE     256
+#define INITIAL_UNDO_CHUNKS 4
+
+// the bits of the castling indicators in an entry
+#define UNDO_WHITE_LEFT_CASTLE  0x1
+#define UNDO_WHITE_RIGHT_CASTLE 0x2
+#define UNDO_BLACK_LEFT_CASTLE  0x4
+#define UNDO_BLACK_RIGHT_CASTLE 0x8
+
+typedef enum sp_undo_stack_message_t {
+	SP_UNDO_STACK_SUCCESS,
+	SP_UNDO_STACK_INVALID_ARGUMENT,
+	SP_UNDO_STACK_MEMORY_FAILURE
+} SP_UNDO_STACK_MESSAGE;
+
+typedef struct undo_entry_t {
+	PackedMove    move;          // the move (a pawn promotion move keeps the type of the piece the pawn was promoted to)
+	char          capturedPiece; // the piece that was captured by the move (an empty position if it didn't capture)
+	unsigned char castling;      // the castling indicators before the move (the UNDO_*_CASTLE bits)
+	unsigned char statusBefore;  // the game status before the move
+	unsigned char statusAfter;   // the game status after the move (saved when the move is undone, for redoing it)
+} UndoEntry;
+
+typedef struct sp_undo_stack_t {
+	UndoEntry** chunks;
+	int         numOfChunks;
+	int         chunksCapacity;
+	int         size; // the number of entries (the played moves and the undone moves that can be redone)
+	int         ply;  // the number of played moves
+} SPUndoStack;
+
+SPUndoStack* spUndoStackCreate(void);
+
+void spUndoStackDestroy(SPUndoStack* stack);
+
+SP_UNDO_STACK_MESSAGE spUndoStackPush(SPUndoStack* stack, const UndoEntry* entry);
+
+UndoEntry* spUndoStackUndo(SPUndoStack* stack);
+
+UndoEntry* spUndoStackRedo(SPUndoStack* stack);
+
+UndoEntry* spUndoStackGetAt(SPUndoStack* stack, int index);
+
+int spUndoStackPly(SPUndoStack* stack);
+
+int spUndoStackSize(SPUndoStack* stack);
+
+bool addUndoChunk(SPUndoStack* stack);
+
+#endif
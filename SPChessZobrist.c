@@ -0,0 +1,86 @@
+#include "SPChessZobrist.h"
+
+/**
+ * The random keys (filled once by spZobristInit).
+ */
+static ZobristKey pieceKeys[NUM_OF_PLAYERS][NUM_OF_PIECE_TYPES][NUM_OF_SQUARES];
+static ZobristKey castleKeys[NUM_OF_CASTLE_INDICATORS];
+static ZobristKey sideKey;
+
+/**
+ * The function fills all the random keys. It should be called once, before any game is created.
+ * The keys are generated by the pseudo random sequence of the magic numbers search with a fixed seed, so the same position
+ * gets the same key on every run.
+ */
+void spZobristInit(void) {
+	uint64_t seed = ZOBRIST_SEED;
+
+	for (int player = 0; player < NUM_OF_PLAYERS; player++)
+		for (int type = 0; type < NUM_OF_PIECE_TYPES; type++)
+			for (int square = 0; square < NUM_OF_SQUARES; square++)
+				pieceKeys[player][type][square] = magicRandom(&seed);
+
+	for (int indicator = 0; indicator < NUM_OF_CASTLE_INDICATORS; indicator++)
+		castleKeys[indicator] = magicRandom(&seed);
+
+	sideKey = magicRandom(&seed);
+}
+
+/**
+ * The function returns the key of a piece of the given player and type that is located on the given square.
+ *
+ * @param player - The player that the piece belongs to
+ * @param type   - The type of the piece
+ * @param square - The square of the piece
+ *
+ * @precondition - spZobristInit was called
+ *
+ * @return
+ * 		The key of the piece on the square.
+ */
+ZobristKey spZobristPieceKey(int player, PIECE_TYPE type, int square) {
+	return pieceKeys[player][type][square];
+}
+
+/**
+ * The function returns the key that is included in the key of a position when it's the black player's turn.
+ *
+ * @precondition - spZobristInit was called
+ *
+ * @return
+ * 		The key of the black player's turn.
+ */
+ZobristKey spZobristSideKey(void) {
+	return sideKey;
+}
+
+/**
+ * The function returns the combined key of the given castling indicators (the XOR of the keys of the available ones).
+ *
+ * @param whiteLeftCastle  - Indicates if the white player may still castle with its left rook
+ * @param whiteRightCastle - Indicates if the white player may still castle with its right rook
+ * @param blackLeftCastle  - Indicates if the black player may still castle with its left rook
+ * @param blackRightCastle - Indicates if the black player may still castle with its right rook
+ *
+ * @precondition - spZobristInit was called
+ *
+ * @return
+ * 		The combined key of the castling indicators.
+ */
+ZobristKey spZobristCastlingKey(bool whiteLeftCastle, bool whiteRightCastle, bool blackLeftCastle, bool blackRightCastle) {
+	ZobristKey key = 0;
+
+	if (whiteLeftCastle)
+		key ^= castleKeys[WHITE_LEFT_CASTLE_INDICATOR];
+
+	if (whiteRightCastle)
+		key ^= castleKeys[WHITE_RIGHT_CASTLE_INDICATOR];
+
+	if (blackLeftCastle)
+		key ^= castleKeys[BLACK_LEFT_CASTLE_INDICATOR];
+
+	if (blackRightCastle)
+		key ^= castleKeys[BLACK_RIGHT_CASTLE_INDICATOR];
+
+	return key;
+}
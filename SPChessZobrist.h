@@ -0,0 +1,57 @@
+#ifndef SPCHESSZOBRIST_H_
+#define SPCHESSZOBRIST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "SPChessBitboard.h"
+
+/**
+ * SPChessZobrist Summary:
+ *
+ * A Zobrist key is a 64 bit word that identifies a Chess position: every (player, piece type, square) combination, the
+ * black player's turn and each of the four castling indicators get their own random key, and the key of a position is the XOR
+ * of the keys of everything that is true in it. Because XOR is its own inverse, the key of a game is updated incrementally
+ * as pieces are placed and removed, the turn passes and castling indicators change.
+ *
+ * spZobristInit        - Fills the random keys (called once at startup)
+ * spZobristPieceKey    - Returns the key of a piece of a given player and type on a given square
+ * spZobristSideKey     - Returns the key that is included when it's the black player's turn
+ * spZobristCastlingKey - Returns the combined key of the castling indicators that are still available
+ */
+
+#define ZOBRIST_SEED 0x5DEECE66DULL
+
+#define ZOBRIST_MISMATCH_ERROR "ERROR: The Zobrist key of the game doesn't match its position (%s)\n"
+
+/**
+ * When compiled with ZOBRIST_DEBUG (see the debug target of the makefile), the incrementally updated key
+ * of the game is compared to a key that is computed from scratch after every change of the game.
+ */
+#ifdef ZOBRIST_DEBUG
+#define ZOBRIST_DEBUG_VERIFY(game) spChessGameVerifyZobristKey((game), __func__)
+#else
+#define ZOBRIST_DEBUG_VERIFY(game)
+#endif
+
+typedef uint64_t ZobristKey;
+
+/**
+ * The four castling indicators of a game, used as an index to their keys.
+ */
+typedef enum castling_indicator_t {
+	WHITE_LEFT_CASTLE_INDICATOR,
+	WHITE_RIGHT_CASTLE_INDICATOR,
+	BLACK_LEFT_CASTLE_INDICATOR,
+	BLACK_RIGHT_CASTLE_INDICATOR,
+	NUM_OF_CASTLE_INDICATORS
+} CASTLE_INDICATOR;
+
+void spZobristInit(void);
+
+ZobristKey spZobristPieceKey(int player, PIECE_TYPE type, int square);
+
+ZobristKey spZobristSideKey(void);
+
+ZobristKey spZobristCastlingKey(bool whiteLeftCastle, bool whiteRightCastle, bool blackLeftCastle, bool blackRightCastle);
+
+#endif
@@ -1,21 +1,43 @@
 #include "SPChessConsoleManager.h"
 #include "SPChessGuiManager.h"
+#include "SPChessBench.h"
 
 #define CONSOLE_MODE "-c"
 #define GUI_MODE "-g"
+#define BENCH_MODE "-b"
+#define BENCH_JSON_OPTION "-json"
 #define CONSOLE_MODE_ENTERED ((argc == 2) && (strcmp(argv[1], CONSOLE_MODE) == 0))
 #define GUI_MODE_ENTERED ((argc == 2) && (strcmp(argv[1], GUI_MODE) == 0))
+#define BENCH_JSON_OPTION_ENTERED ((argc == 3) && (strcmp(argv[2], BENCH_JSON_OPTION) == 0))
+#define BENCH_MODE_ENTERED (((argc == 2) || BENCH_JSON_OPTION_ENTERED) && (strcmp(argv[1], BENCH_MODE) == 0))
 #define GAME_MODE_NOT_ENTERED (argc == 1)
 #define WRONG_GAME_MODE "ERROR: Invalid game mode was chosen"
+#define BENCH_FAILED "ERROR: The bench was stopped by a memory error\n"
 
 int main(int argc, char** argv) {
+	int exitCode = 0;
+
+	// the attack tables of the pieces, the Zobrist keys and the evaluation scores are built once, before any game is created
+	spBitboardInitAttackTables();
+	spZobristInit();
+	spEvaluationInit();
+	spChessTTInit(TT_DEFAULT_SIZE_MB); // the searches run without a transposition table if it couldn't be allocated
+
 	// console mode is also the default when no specific mode was entered
 	if (CONSOLE_MODE_ENTERED || GAME_MODE_NOT_ENTERED)
 		consoleMainLoop();
 	else if (GUI_MODE_ENTERED)
 		guiMainLoop();
+	else if (BENCH_MODE_ENTERED) {
+		// the bench is used for gating engine changes, so its failure is reported by the exit code as well
+		if (!spChessBench(BENCH_JSON_OPTION_ENTERED)) {
+			printf(BENCH_FAILED);
+			exitCode = 1;
+		}
+	}
 	else
 		printf(WRONG_GAME_MODE);
 
-	return 0;
+	spChessTTDestroy();
+	return exitCode;
 }
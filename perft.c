@@ -0,0 +1,61 @@
+#include "SPChessPerft.h"
+#include "SPChessSettingState.h"
+
+#define REGRESSION_MODE_ENTERED (argc == 1)
+#define DIVIDE_MODE_ENTERED ((argc == 2) || (argc == 3))
+#define PERFT_USAGE "Usage: perft                      - checks the regression table\n" \
+					"       perft <depth> [saved game] - prints the \"divide\" of the initial position or of a saved game\n"
+#define INVALID_DEPTH_PERROR printf("ERROR: The depth should be a positive number\n")
+#define REGRESSION_FAILED_PERROR printf("ERROR: Some of the node counts are wrong\n")
+
+int main(int argc, char** argv) {
+	// the attack tables of the pieces, the Zobrist keys and the evaluation scores are built once, before any game is created
+	spBitboardInitAttackTables();
+	spZobristInit();
+	spEvaluationInit();
+
+	if (REGRESSION_MODE_ENTERED) {
+		if (spChessPerftRegression(PERFT_TABLE_DEPTH))
+			return 0;
+
+		REGRESSION_FAILED_PERROR;
+		return 1;
+	}
+
+	if (!DIVIDE_MODE_ENTERED) {
+		printf(PERFT_USAGE);
+		return 1;
+	}
+
+	int depth = atoi(argv[1]);
+	if (depth <= 0) {
+		INVALID_DEPTH_PERROR;
+		return 1;
+	}
+
+	GameSetting setting = { 0 };
+	setting.isGameLoaded = GAME_NOT_LOADED_YET;
+
+	if (argc == 3) {
+		loadGame(argv[2], &setting); // prints its own error messages
+		if (setting.isGameLoaded != GAME_LOADED_SUCCESSFULLY) {
+			spChessGameDestroy(setting.game);
+			return 1;
+		}
+	}
+	else {
+		setting.game = spChessGameCreate();
+		if (setting.game == NULL) {
+			MEMORY_ALLOCATION_PERROR;
+			return 1;
+		}
+	}
+
+	long long startTime = spTimerNowMs();
+	long long nodes     = spChessPerftDivide(setting.game, depth);
+
+	printPerftSummary(nodes, spTimerNowMs() - startTime);
+	spChessGameDestroy(setting.game);
+
+	return 0;
+}